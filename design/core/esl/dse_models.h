@@ -0,0 +1,201 @@
+// Design-Space Exploration Models (ESL)
+// local_cache behaviour plus area and energy proxies for one core configuration
+//
+// cache_model follows local_cache.v: LINE_SIZE-byte lines, ASSOCIATIVITY ways,
+// LRU replacement, blocking on a miss. The proxies rank configurations; they
+// are not sign-off numbers. Area is in kilo gate equivalents (kGE), energy in
+// pJ, both built from 45 nm per-operation figures (Horowitz, ISSCC 2014) and
+// scaled with operand width and array size. No SystemC dependency.
+
+#ifndef DSE_MODELS_H
+#define DSE_MODELS_H
+
+#include <cstdint>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <iomanip>
+
+namespace dse {
+
+// Everything that is a runtime argument of dse_point (the template
+// parameters DATA_WIDTH, MAC_ROWS and MAC_COLS are compiled in)
+struct core_config {
+    int vector_width = 16;          // pe_top_sc VECTOR_WIDTH: operand port and FIFO lanes
+    int cache_size = 32768;         // local_cache CACHE_SIZE, bytes
+    int line_size = 64;             // local_cache LINE_SIZE, bytes
+    int associativity = 4;          // local_cache ASSOCIATIVITY
+    int fifo_depth = 16;            // core FIFO_DEPTH: instruction/operand entries ahead of the PE
+    int route_entries = 8;          // core ROUTE_ENTRIES: router_table size
+    int miss_cycles = 24;           // Line refill over the NoC
+
+    bool valid(std::string* err) const {
+        auto pow2 = [](int v) { return v > 0 && (v & (v - 1)) == 0; };
+        if (!pow2(cache_size) || !pow2(line_size) || !pow2(associativity))
+            return fail("cache_size, line_size and associativity must be powers of two", err);
+        if (cache_size < line_size * associativity)
+            return fail("cache smaller than one set", err);
+        if (vector_width < 1 || fifo_depth < 1 || route_entries < 1 || miss_cycles < 0)
+            return fail("vector_width, fifo_depth and route_entries must be positive", err);
+        return true;
+    }
+
+    void report(std::ostream& os) const {
+        os << "vector_width=" << vector_width << " cache_size=" << cache_size << " line_size=" << line_size
+           << " associativity=" << associativity << " fifo_depth=" << fifo_depth
+           << " route_entries=" << route_entries << " miss_cycles=" << miss_cycles << std::endl;
+    }
+
+private:
+    static bool fail(const char* msg, std::string* err) {
+        if (err) *err = msg;
+        return false;
+    }
+};
+
+// ========================================
+// local_cache
+// ========================================
+class cache_model {
+public:
+    explicit cache_model(const core_config& cfg)
+        : line_bits(log2i(cfg.line_size)), ways(cfg.associativity),
+          sets(cfg.cache_size / (cfg.line_size * cfg.associativity)),
+          tags((size_t)sets * ways, ~uint64_t(0)), stamps((size_t)sets * ways, 0) {}
+
+    // Returns true on a hit; a miss fills the LRU way
+    bool access(uint64_t addr) {
+        const uint64_t line = addr >> line_bits;
+        const size_t set = (size_t)(line % (uint64_t)sets);
+        uint64_t* t = &tags[set * ways];
+        uint64_t* s = &stamps[set * ways];
+        accesses++;
+        clock++;
+        int victim = 0;
+        for (int w = 0; w < ways; w++) {
+            if (t[w] == line) {
+                s[w] = clock;
+                return true;
+            }
+            if (s[w] < s[victim]) victim = w;
+        }
+        misses++;
+        t[victim] = line;
+        s[victim] = clock;
+        return false;
+    }
+
+    // Misses among the lines touched by [addr, addr + bytes)
+    int access_range(uint64_t addr, uint64_t bytes) {
+        int miss = 0;
+        const uint64_t first = addr >> line_bits, last = (addr + bytes - 1) >> line_bits;
+        for (uint64_t l = first; l <= last; l++) miss += !access(l << line_bits);
+        return miss;
+    }
+
+    uint64_t access_count() const { return accesses; }
+    uint64_t miss_count() const { return misses; }
+    double hit_rate() const { return accesses ? 1.0 - (double)misses / accesses : 1.0; }
+
+private:
+    int line_bits, ways, sets;
+    std::vector<uint64_t> tags, stamps;
+    uint64_t clock = 0;
+    uint64_t accesses = 0, misses = 0;
+
+    static int log2i(int v) {
+        int b = 0;
+        while ((1 << b) < v) b++;
+        return b;
+    }
+};
+
+// ========================================
+// Area proxy (kGE)
+// ========================================
+struct area_breakdown {
+    double mac = 0, datapath = 0, fifo = 0, cache = 0, router = 0;
+    double total() const { return mac + datapath + fifo + cache + router; }
+};
+
+const double GE_PER_FF = 6.0;               // Flop with enable
+const double GE_PER_SRAM_BIT = 0.6;         // 6T cell plus periphery
+const double GE_PER_CMP_BIT = 1.5;          // XOR + reduction tree
+const int ADDR_BITS = 32;
+
+inline area_breakdown estimate_area(int dw, int rows, int cols, const core_config& c) {
+    area_breakdown a;
+    const int vw = c.vector_width;
+    const int acc_bits = dw * 2 + 8;
+    // Array multiplier ~ dw^2 full adders, plus a row adder tree and accumulator
+    a.mac = rows * cols * (dw * dw * 7.0 + acc_bits * 8.0) + rows * acc_bits * (GE_PER_FF + 8.0);
+    // Operand/result ports and pipeline registers, activation and norm lanes
+    a.datapath = 4.0 * vw * dw * GE_PER_FF + rows * dw * 60.0 + rows * dw * 20.0;
+    // Instruction FIFO (32-bit words) and operand FIFO (a, b, weight vectors)
+    a.fifo = c.fifo_depth * (32.0 + 3.0 * vw * dw) * GE_PER_FF;
+    // Data array, tag array, way comparators and LRU state
+    const int lines = c.cache_size / c.line_size;
+    const int sets = lines / c.associativity;
+    int tag_bits = ADDR_BITS;
+    for (int v = c.line_size * sets; v > 1; v >>= 1) tag_bits--;
+    a.cache = c.cache_size * 8.0 * GE_PER_SRAM_BIT + lines * (tag_bits + 1.0) * GE_PER_SRAM_BIT +
+              c.associativity * tag_bits * GE_PER_CMP_BIT + lines * 2.0 * GE_PER_FF;
+    // router_table: address + mask + port per entry, one comparator each
+    a.router = c.route_entries * (2.0 * ADDR_BITS + 3.0) * GE_PER_FF + c.route_entries * ADDR_BITS * GE_PER_CMP_BIT;
+    a.mac /= 1000.0;
+    a.datapath /= 1000.0;
+    a.fifo /= 1000.0;
+    a.cache /= 1000.0;
+    a.router /= 1000.0;
+    return a;
+}
+
+// ========================================
+// Energy proxy (pJ)
+// ========================================
+// Event counts collected by dse_point while the workload runs
+struct activity {
+    uint64_t cycles = 0;
+    uint64_t mac_beats = 0;         // Every array cell toggles on a MAC beat
+    uint64_t act_beats = 0;
+    uint64_t softmax_beats = 0;     // exp/fold work instead of a LUT activation
+    uint64_t instr_words = 0;       // Host words through the instruction FIFO
+    uint64_t operand_beats = 0;     // Beats through the operand FIFO and router
+    uint64_t cache_bytes = 0;       // Operand bytes read from local_cache
+    uint64_t cache_misses = 0;
+};
+
+struct energy_breakdown {
+    double mac = 0, act = 0, fifo = 0, cache = 0, refill = 0, router = 0, leakage = 0;
+    double total() const { return mac + act + fifo + cache + refill + router + leakage; }
+};
+
+const double PJ_MUL32 = 3.1;                // 32-bit integer multiply
+const double PJ_ADD32 = 0.1;
+const double PJ_SRAM_8K_64B = 10.0;         // 64-bit read from an 8 KB array
+const double PJ_FF_BIT = 0.012;             // Flop write
+const double PJ_NOC_BIT = 1.25;             // Off-core line refill, per bit
+const double PJ_LEAK_GE_CYCLE = 2e-6;       // ~2 uW/kGE at 1 GHz
+
+inline energy_breakdown estimate_energy(int dw, int rows, int cols, const core_config& c,
+                                        const activity& n, const area_breakdown& area) {
+    energy_breakdown e;
+    const int vw = c.vector_width;
+    const double s = dw / 32.0;
+    e.mac = n.mac_beats * rows * (cols * (PJ_MUL32 * s * s + PJ_ADD32 * s) + PJ_ADD32 * 2.5 * s);
+    e.act = n.act_beats * rows * PJ_ADD32 * 4 * s + n.softmax_beats * rows * (PJ_MUL32 * s * 4);
+    e.fifo = n.instr_words * 32 * PJ_FF_BIT * 2 + n.operand_beats * 3.0 * vw * dw * PJ_FF_BIT * 2;
+    // SRAM energy grows with the square root of the array and the ways read in parallel
+    const double per_word = PJ_SRAM_8K_64B * std::sqrt(c.cache_size / 8192.0) *
+                            (1.0 + 0.15 * (c.associativity - 1));
+    e.cache = (n.cache_bytes / 8.0 + n.cache_misses * c.line_size / 8.0) * per_word;
+    e.refill = n.cache_misses * c.line_size * 8.0 * PJ_NOC_BIT;
+    e.router = n.operand_beats * c.route_entries * ADDR_BITS * PJ_FF_BIT;
+    e.leakage = area.total() * 1000.0 * n.cycles * PJ_LEAK_GE_CYCLE;
+    return e;
+}
+
+} // namespace dse
+
+#endif // DSE_MODELS_H
@@ -0,0 +1,378 @@
+// Design-Space Exploration Point Evaluator
+// One core configuration running one workload: cycles, checked results, area and energy
+//
+// The pe_batch_engine template parameters are compiled in (-DDSE_DATA_WIDTH,
+// -DDSE_MAC_ROWS, -DDSE_MAC_COLS), so dse_sweep builds one binary per
+// template point and reuses it for every vector width, cache, FIFO and router
+// setting, which are arguments here. VECTOR_WIDTH only sizes the operand
+// ports and FIFOs in the area and energy models; MAC_ROWS and MAC_COLS must
+// fit in it. The PE is pe_cmd_queue + pe_batch_engine
+// (cycle-equivalent to pe_cmd_proc_sc + pe_top_sc). Operand beats are fetched
+// through cache_model; a miss holds the fetch for miss_cycles while the FIFO
+// drains into the PE. Outputs are checked against a host reference.
+//
+// Usage: dse_point workload=gemm:M:N:K|softmax:ROWS:LEN vector_width=16
+//                  cache_size=32768 associativity=4 fifo_depth=16
+//                  route_entries=8 [line_size=64 miss_cycles=24]
+//
+// Prints one key=value per line for dse_sweep. Exit status 0 = checked ok,
+// 1 = result mismatch, 2 = bad arguments. No SystemC dependency.
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <memory>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstdint>
+#include "pe_cmd_queue.h"
+#include "pe_batch_engine.h"
+#include "softmax_kernel.h"
+#include "dse_models.h"
+
+#ifndef DSE_DATA_WIDTH
+#define DSE_DATA_WIDTH 32
+#endif
+#ifndef DSE_MAC_ROWS
+#define DSE_MAC_ROWS 8
+#endif
+#ifndef DSE_MAC_COLS
+#define DSE_MAC_COLS 8
+#endif
+
+const int DATA_WIDTH = DSE_DATA_WIDTH;
+const int MAC_ROWS = DSE_MAC_ROWS;
+const int MAC_COLS = DSE_MAC_COLS;
+
+typedef pe_batch_engine<DATA_WIDTH, MAC_ROWS, MAC_COLS, 1> engine_t;
+
+const uint32_t MAC_LOAD = 0x10000000;
+const uint32_t MAC_ACC = 0x12000000;
+const uint32_t MAC_DRAIN = 0x13000000;
+const uint32_t ACT_RELU = 0x20000001;
+const uint32_t SMAX_LOAD = 0x20000005;
+const uint32_t SMAX_ACC = 0x22000005;
+const uint32_t SMAX_DRAIN = 0x23000005;
+
+// Operand bytes read from local_cache for one beat
+struct mem_range {
+    uint64_t addr;
+    uint64_t bytes;
+};
+
+class workload {
+public:
+    virtual ~workload() {}
+    virtual std::vector<uint32_t> program() const = 0;
+    virtual size_t beats() const = 0;
+    virtual int ranges(size_t beat, mem_range* r) const = 0;   // Up to 2
+    virtual void fill(size_t beat, int32_t* b, int32_t* w) const = 0;
+    virtual bool checks(uint32_t instr) const = 0;             // Output compared?
+    virtual void output(const int32_t* lanes) = 0;              // MAC_ROWS lanes
+    virtual double work() const = 0;
+    virtual const char* unit() const = 0;
+    size_t mismatches = 0, outputs = 0;
+};
+
+// Element value in [-7, 7], reproducible from its index
+inline int32_t elem(uint32_t seed, uint64_t i) {
+    uint32_t h = (uint32_t)(i * 2654435761u) ^ seed;
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 12;
+    return (int32_t)(h % 15) - 7;
+}
+
+const uint64_t W_BASE = 0x10000000;
+const uint64_t X_BASE = 0x40000000;
+const uint64_t EB = DATA_WIDTH / 8 ? DATA_WIDTH / 8 : 1;        // Bytes per element
+
+// Emit LOOP(body, count) in chunks of the 16-bit count field
+static void emit_loop(std::vector<uint32_t>& p, const std::vector<uint32_t>& body, uint64_t count) {
+    while (count) {
+        const uint32_t n = count > 0xFFFF ? 0xFFFF : (uint32_t)count;
+        p.push_back(pe_ucode::loop((uint32_t)body.size(), n));
+        p.insert(p.end(), body.begin(), body.end());
+        count -= n;
+    }
+}
+
+// Y[n, m] = relu(sum_k W[k, m] * X[n, k]): one tile is MAC_ROWS outputs of
+// one column n, K beats of W[k, m0:m0+R] with x[n, k] in weight lane 0. W is
+// packed in MAC_ROWS-wide panels (K x R, contiguous) and tiles run m0-major,
+// so a panel is reused across all N, and X across panels, if they stay cached.
+class gemm_workload : public workload {
+public:
+    gemm_workload(uint64_t m, uint64_t n, uint64_t k) : M(m), N(n), K(k) {}
+
+    std::vector<uint32_t> program() const override {
+        std::vector<uint32_t> p;
+        emit_loop(p, { MAC_LOAD, pe_ucode::repeat((uint32_t)(K - 1)), MAC_ACC, MAC_DRAIN, ACT_RELU },
+                  tiles());
+        p.push_back(pe_ucode::halt());
+        return p;
+    }
+    size_t beats() const override { return tiles() * K; }             // LOAD and ACCs; DRAIN takes none
+
+    int ranges(size_t beat, mem_range* r) const override {
+        uint64_t m0, n, k;
+        locate(beat, m0, n, k);
+        r[0] = { W_BASE + (m0 * K + k * MAC_ROWS) * EB, MAC_ROWS * EB };
+        r[1] = { X_BASE + (n * K + k) * EB, EB };
+        return 2;
+    }
+
+    void fill(size_t beat, int32_t* b, int32_t* w) const override {
+        uint64_t m0, n, k;
+        locate(beat, m0, n, k);
+        for (int c = 0; c < MAC_COLS; c++) w[c] = 0;
+        for (int r = 0; r < MAC_ROWS; r++) b[r] = elem(1, k * M + m0 + r);
+        w[0] = elem(2, n * K + k);
+    }
+
+    bool checks(uint32_t instr) const override { return instr == MAC_DRAIN; }
+
+    void output(const int32_t* lanes) override {
+        const uint64_t t = outputs++;
+        const uint64_t m0 = (t / N) * MAC_ROWS, n = t % N;
+        const int64_t max_val = (int64_t(1) << (DATA_WIDTH - 1)) - 1;
+        for (int r = 0; r < MAC_ROWS; r++) {
+            int64_t acc = 0;
+            for (uint64_t k = 0; k < K; k++) acc += (int64_t)elem(1, k * M + m0 + r) * elem(2, n * K + k);
+            acc = acc > max_val ? max_val : (acc < -max_val - 1 ? -max_val - 1 : acc);
+            mismatches += lanes[r] != engine_t::to_lane(acc);
+        }
+    }
+
+    double work() const override { return (double)M * N * K; }
+    const char* unit() const override { return "mac"; }
+
+private:
+    uint64_t M, N, K;
+    uint64_t tiles() const { return M / MAC_ROWS * N; }
+    void locate(size_t beat, uint64_t& m0, uint64_t& n, uint64_t& k) const {
+        const uint64_t t = beat / K;
+        k = beat % K;
+        m0 = (t / N) * MAC_ROWS;
+        n = t % N;
+    }
+};
+
+// Row-wise softmax over LEN inputs in [0, 4): a statistics pass and a
+// normalizing pass, both streaming the row through MAC LOAD (x * 1), so the
+// second pass hits in local_cache only if a whole row fits.
+class softmax_workload : public workload {
+public:
+    softmax_workload(uint64_t rows, uint64_t len) : ROWS(rows), LEN(len), NB(len / MAC_ROWS) {}
+
+    std::vector<uint32_t> program() const override {
+        std::vector<uint32_t> row = { MAC_LOAD, SMAX_LOAD,
+                                      pe_ucode::loop(2, (uint32_t)(NB - 1)), MAC_LOAD, SMAX_ACC,
+                                      pe_ucode::loop(2, (uint32_t)NB), MAC_LOAD, SMAX_DRAIN };
+        std::vector<uint32_t> p;
+        emit_loop(p, row, ROWS);
+        p.push_back(pe_ucode::halt());
+        return p;
+    }
+    size_t beats() const override { return ROWS * NB * 2; }
+
+    int ranges(size_t beat, mem_range* r) const override {
+        const uint64_t row = beat / (2 * NB), j = beat % NB;
+        r[0] = { X_BASE + (row * LEN + j * MAC_ROWS) * EB, MAC_ROWS * EB };
+        return 1;
+    }
+
+    void fill(size_t beat, int32_t* b, int32_t* w) const override {
+        const uint64_t row = beat / (2 * NB), j = beat % NB;
+        for (int r = 0; r < MAC_ROWS; r++) b[r] = quant(row * LEN + j * MAC_ROWS + r);
+        for (int c = 0; c < MAC_COLS; c++) w[c] = c == 0;
+    }
+
+    bool checks(uint32_t instr) const override { return instr == SMAX_DRAIN; }
+
+    void output(const int32_t* lanes) override {
+        const uint64_t row = outputs / NB, j = outputs % NB;
+        outputs++;
+        if (j == 0) {
+            std::vector<float> x(LEN);
+            for (uint64_t e = 0; e < LEN; e++) x[e] = (float)(quant(row * LEN + e) / SCALE);
+            expected.resize(LEN);
+            softmax_kernel::softmax_reference(x.data(), expected.data(), (int)LEN);
+        }
+        // Probabilities come back in Q(DATA_WIDTH/2); allow a rounding step
+        for (int r = 0; r < MAC_ROWS; r++)
+            mismatches += std::fabs(lanes[r] / SCALE - expected[j * MAC_ROWS + r]) > 1.5 / SCALE;
+    }
+
+    double work() const override { return (double)ROWS * LEN; }
+    const char* unit() const override { return "elem"; }
+
+private:
+    uint64_t ROWS, LEN, NB;
+    std::vector<float> expected;
+    static constexpr double SCALE = (double)(int64_t(1) << engine_t::SMAX_FRAC_BITS);
+    static int32_t quant(uint64_t i) { return (int32_t)std::lround((elem(3, i) + 7) / 14.0 * 4.0 * SCALE); }
+};
+
+static std::unique_ptr<workload> make_workload(const std::string& spec, std::string* err) {
+    std::vector<uint64_t> v;
+    const size_t colon = spec.find(':');
+    const std::string kind = spec.substr(0, colon);
+    for (size_t p = colon; p != std::string::npos; p = spec.find(':', p + 1))
+        v.push_back(std::strtoull(spec.c_str() + p + 1, nullptr, 10));
+    if (kind == "gemm" && v.size() == 3 && v[0] && v[1] && v[2] >= 2) {
+        if (v[0] % MAC_ROWS) {
+            *err = "gemm M must be a multiple of MAC_ROWS";
+            return nullptr;
+        }
+        return std::unique_ptr<workload>(new gemm_workload(v[0], v[1], v[2]));
+    }
+    if (kind == "softmax" && v.size() == 2 && v[0]) {
+        if (v[1] % MAC_ROWS || v[1] / MAC_ROWS < 2 || v[1] / MAC_ROWS > 0xFFFF) {
+            *err = "softmax LEN must be 2..65535 beats of MAC_ROWS";
+            return nullptr;
+        }
+        return std::unique_ptr<workload>(new softmax_workload(v[0], v[1]));
+    }
+    *err = "unknown workload '" + spec + "' (gemm:M:N:K or softmax:ROWS:LEN)";
+    return nullptr;
+}
+
+int main(int argc, char* argv[]) {
+    dse::core_config cfg;
+    std::string spec = "gemm:128:32:256";
+    for (int i = 1; i < argc; i++) {
+        const std::string a = argv[i];
+        const size_t eq = a.find('=');
+        const std::string key = a.substr(0, eq);
+        const std::string val = eq == std::string::npos ? "" : a.substr(eq + 1);
+        const int n = std::atoi(val.c_str());
+        if (key == "workload") spec = val;
+        else if (key == "vector_width") cfg.vector_width = n;
+        else if (key == "cache_size") cfg.cache_size = n;
+        else if (key == "line_size") cfg.line_size = n;
+        else if (key == "associativity") cfg.associativity = n;
+        else if (key == "fifo_depth") cfg.fifo_depth = n;
+        else if (key == "route_entries") cfg.route_entries = n;
+        else if (key == "miss_cycles") cfg.miss_cycles = n;
+        else {
+            std::cerr << "dse_point: unknown argument " << a << std::endl;
+            return 2;
+        }
+    }
+    std::string err;
+    std::unique_ptr<workload> wl = make_workload(spec, &err);
+    if (!wl || !cfg.valid(&err)) {
+        std::cerr << "dse_point: " << err << std::endl;
+        return 2;
+    }
+    // MAC lanes are carried on the VECTOR_WIDTH operand ports
+    if (MAC_ROWS > cfg.vector_width || MAC_COLS > cfg.vector_width) {
+        std::cerr << "dse_point: mac_rows and mac_cols must not exceed vector_width" << std::endl;
+        return 2;
+    }
+
+    pe_cmd_config qcfg;
+    qcfg.instr_depth = cfg.fifo_depth;
+    qcfg.operand_depth = cfg.fifo_depth;
+    pe_cmd_queue<uint32_t> queue(qcfg);
+    std::unique_ptr<engine_t> engine(new engine_t());
+    dse::cache_model cache(cfg);
+    dse::activity act;
+
+    const std::vector<uint32_t> prog = wl->program();
+    const size_t total_beats = wl->beats();
+    size_t next_word = 0, next_beat = 0;
+    bool fetching = false;          // Beat next_beat is waiting on a refill
+    uint64_t ready_at = 0;
+    int32_t b[MAC_ROWS], w[MAC_COLS], zeros[MAC_ROWS > MAC_COLS ? MAC_ROWS : MAC_COLS] = {};
+    int32_t lanes[MAC_ROWS];
+    const uint32_t idle = 0;
+    const uint8_t valid_on = 1, valid_off = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    uint64_t cycle = 0;
+    for (;; cycle++) {
+        // Host: one instruction word per cycle
+        if (next_word < prog.size() && queue.push_instr(prog[next_word])) next_word++;
+
+        // Operand fetch through local_cache, blocking on a miss
+        if (!fetching && next_beat < total_beats && !queue.operand_full()) {
+            mem_range r[2];
+            const int nr = wl->ranges(next_beat, r);
+            int miss = 0;
+            for (int i = 0; i < nr; i++) {
+                miss += cache.access_range(r[i].addr, r[i].bytes);
+                act.cache_bytes += r[i].bytes;
+            }
+            act.cache_misses += miss;
+            fetching = true;
+            ready_at = cycle + (uint64_t)miss * cfg.miss_cycles;
+        }
+        if (fetching && cycle >= ready_at && queue.push_operand((uint32_t)next_beat)) {
+            fetching = false;
+            next_beat++;
+            act.operand_beats++;
+        }
+
+        uint32_t instr = 0, beat = 0;
+        const bool issued = queue.step(true, instr, beat);
+        const int32_t* bp = zeros;
+        const int32_t* wp = zeros;
+        if (issued && pe_ucode::needs_operand(instr)) {
+            wl->fill(beat, b, w);
+            bp = b;
+            wp = w;
+        }
+        engine->step(issued ? &instr : &idle, issued ? &valid_on : &valid_off, bp, wp);
+
+        if (issued) {
+            switch (instr >> 28) {
+                case 1: act.mac_beats++; break;
+                case 2: ((instr & 0xFF) == 5 ? act.softmax_beats : act.act_beats)++; break;
+            }
+            if (wl->checks(instr)) {
+                for (int r = 0; r < MAC_ROWS; r++) lanes[r] = engine->select_output(instr, r)[0];
+                wl->output(lanes);
+            }
+        }
+        if (queue.has_error()) {
+            std::cerr << "dse_point: " << queue.error_message() << std::endl;
+            return 2;
+        }
+        if (queue.is_halted()) break;
+    }
+    act.cycles = cycle + 1;
+    act.instr_words = next_word;
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    const dse::area_breakdown area = dse::estimate_area(DATA_WIDTH, MAC_ROWS, MAC_COLS, cfg);
+    const dse::energy_breakdown energy =
+        dse::estimate_energy(DATA_WIDTH, MAC_ROWS, MAC_COLS, cfg, act, area);
+    const bool ok = wl->mismatches == 0 && wl->outputs > 0;
+
+    std::cout << std::setprecision(6)
+              << "data_width=" << DATA_WIDTH << "\nvector_width=" << cfg.vector_width
+              << "\nmac_rows=" << MAC_ROWS << "\nmac_cols=" << MAC_COLS
+              << "\ncache_size=" << cfg.cache_size << "\nassociativity=" << cfg.associativity
+              << "\nfifo_depth=" << cfg.fifo_depth << "\nroute_entries=" << cfg.route_entries
+              << "\nworkload=" << spec << "\nunit=" << wl->unit()
+              << "\ncycles=" << act.cycles << "\nwork=" << wl->work()
+              << "\nthroughput=" << wl->work() / act.cycles
+              << "\nmac_util=" << (double)act.mac_beats / act.cycles
+              << "\nstall_operand=" << queue.stall_count(pe_cmd_queue<uint32_t>::STALL_OPERAND)
+              << "\ncache_hit_rate=" << cache.hit_rate()
+              << "\narea_kge=" << area.total() << "\narea_mac=" << area.mac
+              << "\narea_datapath=" << area.datapath << "\narea_fifo=" << area.fifo
+              << "\narea_cache=" << area.cache << "\narea_router=" << area.router
+              << "\nenergy_pj=" << energy.total() << "\nenergy_per_op_pj=" << energy.total() / wl->work()
+              << "\nenergy_mac=" << energy.mac << "\nenergy_act=" << energy.act
+              << "\nenergy_fifo=" << energy.fifo << "\nenergy_cache=" << energy.cache
+              << "\nenergy_refill=" << energy.refill << "\nenergy_router=" << energy.router
+              << "\nenergy_leakage=" << energy.leakage
+              << "\nmismatches=" << wl->mismatches << "\ncheck=" << (ok ? "ok" : "FAIL")
+              << "\nsim_seconds=" << seconds << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,608 @@
+// Design-Space Exploration Sweep Runner
+// Parallel grid sweep of core configurations with a result cache and Pareto fronts
+//
+// Reads a parameter grid (see dse_grid.txt), expands it to configurations x
+// workloads and runs each as a dse_point process. Template parameters
+// (DATA_WIDTH, MAC_ROWS, MAC_COLS) select a dse_point binary, built on demand
+// into build_dir and reused while its sources are unchanged.
+// A small scheduler keeps `jobs` processes busy: builds first, then the
+// longest evaluations first, each evaluation waiting only on its own build.
+// Results land in cache_dir under a hash of the evaluator sources, the
+// configuration and the workload, so an interrupted or extended sweep only
+// runs what is missing.
+//
+// Output: every point in a CSV, flagged when it is on the per-workload
+// Pareto front of throughput (max), area proxy (min) and energy per op (min),
+// plus the 2-D throughput/area and throughput/energy fronts on stdout.
+//
+// Usage: dse_sweep [grid=dse_grid.txt] [jobs=<cores>] [out=dse_results.csv]
+//                  [build_dir=dse_build] [cache_dir=dse_cache] [esl_dir=../../pe_core/esl]
+//                  [cxx=g++] [rerun=0] [dry_run=0]
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <map>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// ========================================
+// Grid
+// ========================================
+// Swept parameters in CSV column order; the first four describe the PE, and
+// DATA_WIDTH, MAC_ROWS and MAC_COLS are its template parameters
+static const char* const PARAMS[] = { "DATA_WIDTH", "VECTOR_WIDTH", "MAC_ROWS", "MAC_COLS",
+                                      "CACHE_SIZE", "ASSOCIATIVITY", "FIFO_DEPTH", "ROUTE_ENTRIES",
+                                      "LINE_SIZE", "MISS_CYCLES" };
+static const int NUM_PARAMS = 10;
+static const int DEFAULTS[NUM_PARAMS] = { 32, 16, 8, 8, 32768, 4, 16, 8, 64, 24 };
+
+struct grid {
+    std::vector<int> values[NUM_PARAMS];
+    std::vector<std::string> workloads;
+};
+
+static std::string trim(const std::string& s) {
+    const size_t a = s.find_first_not_of(" \t\r");
+    const size_t b = s.find_last_not_of(" \t\r");
+    return a == std::string::npos ? "" : s.substr(a, b - a + 1);
+}
+
+// NAME = v1, v2, ...   (one line per parameter; workload lines may repeat)
+static bool load_grid(const std::string& path, grid& g, std::string* err) {
+    std::ifstream in(path);
+    if (!in) {
+        *err = "cannot open " + path;
+        return false;
+    }
+    std::string line;
+    for (int n = 1; std::getline(in, line); n++) {
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+        const size_t eq = line.find('=');
+        if (eq == std::string::npos) {
+            *err = path + ":" + std::to_string(n) + ": expected NAME = values";
+            return false;
+        }
+        const std::string name = trim(line.substr(0, eq));
+        std::stringstream vals(line.substr(eq + 1));
+        std::string v;
+        int p = 0;
+        while (p < NUM_PARAMS && name != PARAMS[p]) p++;
+        if (name != "workload" && p == NUM_PARAMS) {
+            *err = path + ":" + std::to_string(n) + ": unknown parameter " + name;
+            return false;
+        }
+        while (std::getline(vals, v, ',')) {
+            v = trim(v);
+            if (v.empty()) continue;
+            if (name == "workload") g.workloads.push_back(v);
+            else g.values[p].push_back(std::atoi(v.c_str()));
+        }
+    }
+    for (int p = 0; p < NUM_PARAMS; p++)
+        if (g.values[p].empty()) g.values[p].push_back(DEFAULTS[p]);
+    if (g.workloads.empty()) g.workloads.push_back("gemm:128:32:256");
+    return true;
+}
+
+// Combinations pe_top_sc and local_cache can be instantiated with
+static bool legal(const int* v) {
+    const int dw = v[0], vw = v[1], rows = v[2], cols = v[3];
+    const int cache = v[4], assoc = v[5], line = v[8];
+    return (dw == 8 || dw == 16 || dw == 32) && rows >= 1 && cols >= 1 && rows <= vw && cols <= vw &&
+           cache >= line * assoc && v[6] >= 1 && v[7] >= 1;
+}
+
+// ========================================
+// Hashing and files
+// ========================================
+static uint64_t fnv1a(const std::string& s, uint64_t h = 1469598103934665603ull) {
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+static std::string hex(uint64_t v) {
+    char buf[17];
+    std::snprintf(buf, sizeof(buf), "%016llx", (unsigned long long)v);
+    return buf;
+}
+
+static bool read_file(const std::string& path, std::string& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    out = ss.str();
+    return true;
+}
+
+static bool exists(const std::string& path) {
+    struct stat st;
+    return stat(path.c_str(), &st) == 0;
+}
+
+// key=value lines from a dse_point run
+static std::map<std::string, std::string> parse_kv(const std::string& text) {
+    std::map<std::string, std::string> kv;
+    std::istringstream in(text);
+    std::string line;
+    while (std::getline(in, line)) {
+        const size_t eq = line.find('=');
+        if (eq != std::string::npos && eq > 0) kv[line.substr(0, eq)] = line.substr(eq + 1);
+    }
+    return kv;
+}
+
+// ========================================
+// Jobs
+// ========================================
+struct job {
+    enum kind_t { BUILD, EVAL } kind;
+    std::vector<std::string> argv;
+    std::string out_path;           // Final file, renamed from tmp once the job succeeds
+    std::string tmp;
+    std::string log_path;           // Compiler output for builds
+    int dep = -1;                   // Build job this evaluation waits for
+    double cost = 0.0;              // Estimated cycles, for longest-first ordering
+    int point = -1;
+    enum state_t { WAITING, RUNNING, DONE, FAILED } state = WAITING;
+    pid_t pid = 0;
+    std::chrono::steady_clock::time_point start;
+    double seconds = 0.0;
+};
+
+struct point {
+    int v[NUM_PARAMS];
+    std::string workload;
+    std::string binary;
+    std::string result_path;
+    std::map<std::string, std::string> kv;
+    std::string source = "-";       // cached, ran, failed
+    bool ok = false;
+    bool front3 = false, front_area = false, front_energy = false;
+
+    double num(const char* key) const {
+        auto it = kv.find(key);
+        return it == kv.end() ? 0.0 : std::atof(it->second.c_str());
+    }
+};
+
+// PE shape, and the part of it that selects a dse_point build
+static std::string pe_tag(const int* v) {
+    return "dw" + std::to_string(v[0]) + "_vw" + std::to_string(v[1]) + "_r" + std::to_string(v[2]) +
+           "_c" + std::to_string(v[3]);
+}
+
+static std::string template_tag(const int* v) {
+    return "dw" + std::to_string(v[0]) + "_r" + std::to_string(v[2]) + "_c" + std::to_string(v[3]);
+}
+
+// Rough issue-slot count so the longest evaluations start first
+static double estimate_cost(const point& p) {
+    std::vector<double> d;
+    const size_t colon = p.workload.find(':');
+    for (size_t c = colon; c != std::string::npos; c = p.workload.find(':', c + 1))
+        d.push_back(std::atof(p.workload.c_str() + c + 1));
+    const double rows = p.v[2];
+    if (p.workload.compare(0, colon, "gemm") == 0 && d.size() == 3) return d[0] / rows * d[1] * (d[2] + 3);
+    if (p.workload.compare(0, colon, "softmax") == 0 && d.size() == 2) return d[0] * d[1] / rows * 4;
+    return 0.0;
+}
+
+class scheduler {
+public:
+    explicit scheduler(int slots) : slots(slots) {}
+
+    int add(const job& j) {
+        jobs.push_back(j);
+        return (int)jobs.size() - 1;
+    }
+    std::vector<job>& all() { return jobs; }
+
+    // Runs every job; on_done(index) is called as each one finishes
+    template <typename F>
+    void run(F on_done) {
+        std::vector<int> order(jobs.size());
+        for (size_t i = 0; i < jobs.size(); i++) order[i] = (int)i;
+        std::stable_sort(order.begin(), order.end(), [this](int a, int b) {
+            if (jobs[a].kind != jobs[b].kind) return jobs[a].kind == job::BUILD;
+            return jobs[a].cost > jobs[b].cost;
+        });
+
+        size_t finished = 0;
+        int running = 0;
+        while (finished < jobs.size()) {
+            // Fill free slots with the first ready job in priority order
+            for (size_t k = 0; k < order.size() && running < slots; k++) {
+                job& j = jobs[order[k]];
+                if (j.state != job::WAITING) continue;
+                if (j.dep >= 0 && jobs[j.dep].state == job::FAILED) {
+                    j.state = job::FAILED;
+                    finished++;
+                    on_done(order[k]);
+                    continue;
+                }
+                if (j.dep >= 0 && jobs[j.dep].state != job::DONE) continue;
+                if (spawn(j)) {
+                    running++;
+                } else {
+                    j.state = job::FAILED;
+                    finished++;
+                    on_done(order[k]);
+                }
+            }
+            if (!running) continue;
+
+            int status = 0;
+            const pid_t pid = waitpid(-1, &status, 0);
+            if (pid < 0) break;
+            for (size_t i = 0; i < jobs.size(); i++) {
+                job& j = jobs[i];
+                if (j.state != job::RUNNING || j.pid != pid) continue;
+                running--;
+                finished++;
+                j.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - j.start).count();
+                const std::string& tmp = j.tmp;
+                // dse_point exits 1 on a result mismatch: keep the output, it is a real result
+                const int code = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+                const bool ok = j.kind == job::EVAL ? (code == 0 || code == 1) : code == 0;
+                if (ok && std::rename(tmp.c_str(), j.out_path.c_str()) == 0) {
+                    j.state = job::DONE;
+                } else {
+                    j.state = job::FAILED;
+                    if (j.kind == job::EVAL) std::rename(tmp.c_str(), (j.out_path + ".failed").c_str());
+                    else unlink(tmp.c_str());
+                }
+                on_done((int)i);
+                break;
+            }
+        }
+    }
+
+private:
+    int slots;
+    std::vector<job> jobs;
+
+    bool spawn(job& j) {
+        j.tmp = j.out_path + ".tmp." + std::to_string(getpid());
+        // Builds write the binary (last argument) themselves; evaluations write stdout
+        if (j.kind == job::BUILD) j.argv.back() = j.tmp;
+        std::vector<char*> args;
+        for (std::string& a : j.argv) args.push_back(&a[0]);
+        args.push_back(nullptr);
+        const std::string out = j.kind == job::EVAL ? j.tmp : j.log_path;
+        const pid_t pid = fork();
+        if (pid < 0) return false;
+        if (pid == 0) {
+            const int fd = open(out.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (fd >= 0) {
+                dup2(fd, 1);
+                dup2(fd, 2);
+                close(fd);
+            }
+            execvp(args[0], args.data());
+            _exit(127);
+        }
+        j.pid = pid;
+        j.state = job::RUNNING;
+        j.start = std::chrono::steady_clock::now();
+        return true;
+    }
+};
+
+// ========================================
+// Pareto fronts
+// ========================================
+// a dominates b: no worse in every objective and better in one
+static bool dominates(const point& a, const point& b, bool use_area, bool use_energy) {
+    const double ta = a.num("throughput"), tb = b.num("throughput");
+    const double aa = a.num("area_kge"), ab = b.num("area_kge");
+    const double ea = a.num("energy_per_op_pj"), eb = b.num("energy_per_op_pj");
+    bool better = ta > tb;
+    if (ta < tb) return false;
+    if (use_area) {
+        if (aa > ab) return false;
+        better |= aa < ab;
+    }
+    if (use_energy) {
+        if (ea > eb) return false;
+        better |= ea < eb;
+    }
+    return better;
+}
+
+static void mark_fronts(std::vector<point>& pts, const std::string& wl) {
+    for (point& p : pts) {
+        if (p.workload != wl || !p.ok) continue;
+        p.front3 = p.front_area = p.front_energy = true;
+        for (const point& q : pts) {
+            if (q.workload != wl || !q.ok || &q == &p) continue;
+            if (dominates(q, p, true, true)) p.front3 = false;
+            if (dominates(q, p, true, false)) p.front_area = false;
+            if (dominates(q, p, false, true)) p.front_energy = false;
+        }
+    }
+}
+
+static void print_front(const std::vector<point>& pts, const std::string& wl, bool area) {
+    std::vector<const point*> f;
+    for (const point& p : pts)
+        if (p.workload == wl && (area ? p.front_area : p.front_energy)) f.push_back(&p);
+    std::sort(f.begin(), f.end(), [](const point* a, const point* b) {
+        return a->num("throughput") < b->num("throughput");
+    });
+    std::cout << "\n  Throughput vs " << (area ? "area" : "energy") << " front (" << f.size()
+              << " points)" << std::endl;
+    std::cout << "  " << std::left << std::setw(22) << "PE" << std::setw(8) << "Cache"
+              << std::setw(6) << "Ways" << std::setw(6) << "FIFO" << std::setw(7) << "Route" << std::right
+              << std::setw(12) << "Throughput" << std::setw(11) << "Area kGE" << std::setw(11) << "pJ/op"
+              << std::setw(9) << "Hit %" << std::endl;
+    for (const point* p : f) {
+        std::cout << "  " << std::left << std::setw(22) << pe_tag(p->v) << std::setw(8)
+                  << (std::to_string(p->v[4] / 1024) + "K") << std::setw(6) << p->v[5] << std::setw(6)
+                  << p->v[6] << std::setw(7) << p->v[7] << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(12) << p->num("throughput") << std::setprecision(1) << std::setw(11)
+                  << p->num("area_kge") << std::setprecision(2) << std::setw(11) << p->num("energy_per_op_pj")
+                  << std::setprecision(1) << std::setw(9) << 100.0 * p->num("cache_hit_rate")
+                  << std::defaultfloat << std::endl;
+    }
+}
+
+static bool write_csv(const std::string& path, const std::vector<point>& pts) {
+    std::ofstream out(path);
+    if (!out) return false;
+    out << "workload";
+    for (int p = 0; p < NUM_PARAMS; p++) out << "," << PARAMS[p];
+    out << ",cycles,throughput,unit,mac_util,cache_hit_rate,area_kge,energy_pj,energy_per_op_pj,"
+           "check,source,pareto,front_area,front_energy\n";
+    for (const point& p : pts) {
+        out << p.workload;
+        for (int k = 0; k < NUM_PARAMS; k++) out << "," << p.v[k];
+        auto get = [&p](const char* k) {
+            auto it = p.kv.find(k);
+            return it == p.kv.end() ? std::string() : it->second;
+        };
+        out << "," << get("cycles") << "," << get("throughput") << "," << get("unit") << ","
+            << get("mac_util") << "," << get("cache_hit_rate") << "," << get("area_kge") << ","
+            << get("energy_pj") << "," << get("energy_per_op_pj") << ","
+            << (p.kv.count("check") ? get("check") : "none") << "," << p.source << "," << p.front3 << ","
+            << p.front_area << "," << p.front_energy << "\n";
+    }
+    return (bool)out;
+}
+
+int main(int argc, char* argv[]) {
+    std::string grid_path = "dse_grid.txt", out_path = "dse_results.csv";
+    std::string build_dir = "dse_build", cache_dir = "dse_cache", esl_dir = "../../pe_core/esl";
+    std::string cxx = "g++";
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int jobs = cores > 0 ? (int)cores : 1;
+    bool rerun = false, dry_run = false;
+    for (int i = 1; i < argc; i++) {
+        const std::string a = argv[i];
+        const size_t eq = a.find('=');
+        const std::string key = a.substr(0, eq);
+        const std::string val = eq == std::string::npos ? "" : a.substr(eq + 1);
+        if (key == "grid") grid_path = val;
+        else if (key == "jobs") jobs = std::max(1, std::atoi(val.c_str()));
+        else if (key == "out") out_path = val;
+        else if (key == "build_dir") build_dir = val;
+        else if (key == "cache_dir") cache_dir = val;
+        else if (key == "esl_dir") esl_dir = val;
+        else if (key == "cxx") cxx = val;
+        else if (key == "rerun") rerun = std::atoi(val.c_str()) != 0;
+        else if (key == "dry_run") dry_run = std::atoi(val.c_str()) != 0;
+        else {
+            std::cerr << "dse_sweep: unknown argument " << a << std::endl;
+            return 2;
+        }
+    }
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "Core Design-Space Exploration Sweep" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    grid g;
+    std::string err;
+    if (!load_grid(grid_path, g, &err)) {
+        std::cerr << "dse_sweep: " << err << std::endl;
+        return 2;
+    }
+
+    // Evaluator identity: any source or flag change invalidates binaries and results
+    const std::vector<std::string> sources = { "dse_point.cpp", "dse_models.h", esl_dir + "/pe_cmd_queue.h",
+                                               esl_dir + "/pe_batch_engine.h", esl_dir + "/softmax_kernel.h" };
+    const std::vector<std::string> flags = { "-std=c++17", "-O3", "-march=native", "-I" + esl_dir };
+    uint64_t src_hash = fnv1a(cxx);
+    for (const std::string& f : flags) src_hash = fnv1a(f, src_hash);
+    for (const std::string& s : sources) {
+        std::string text;
+        if (!read_file(s, text)) {
+            std::cerr << "dse_sweep: cannot read " << s << std::endl;
+            return 2;
+        }
+        src_hash = fnv1a(text, src_hash);
+    }
+    const std::string src_tag = hex(src_hash).substr(0, 8);
+
+    // Expand the grid
+    std::vector<point> pts;
+    size_t combos = 1, illegal = 0;
+    for (int p = 0; p < NUM_PARAMS; p++) combos *= g.values[p].size();
+    for (size_t c = 0; c < combos; c++) {
+        point pt;
+        size_t r = c;
+        for (int p = NUM_PARAMS - 1; p >= 0; p--) {
+            pt.v[p] = g.values[p][r % g.values[p].size()];
+            r /= g.values[p].size();
+        }
+        if (!legal(pt.v)) {
+            illegal++;
+            continue;
+        }
+        for (const std::string& wl : g.workloads) {
+            pt.workload = wl;
+            pts.push_back(pt);
+        }
+    }
+    const size_t configs = pts.size() / g.workloads.size();
+    std::cout << "Grid: " << grid_path << ", " << configs << " configurations x " << g.workloads.size()
+              << " workloads = " << pts.size() << " points (" << illegal << " illegal combinations skipped)"
+              << std::endl;
+
+    mkdir(build_dir.c_str(), 0755);
+    mkdir(cache_dir.c_str(), 0755);
+
+    // Cached results, then one build per missing template point, then evaluations
+    scheduler sched(jobs);
+    std::map<std::string, int> build_job;
+    std::map<std::string, bool> binaries;
+    size_t cached = 0;
+    for (size_t i = 0; i < pts.size(); i++) {
+        point& p = pts[i];
+        const std::string tag = template_tag(p.v);
+        p.binary = build_dir + "/dse_point_" + tag + "_" + src_tag;
+        std::string key = src_tag + "|" + p.workload;
+        for (int k = 0; k < NUM_PARAMS; k++) key += "|" + std::to_string(p.v[k]);
+        p.result_path = cache_dir + "/" + hex(fnv1a(key)) + ".txt";
+
+        std::string text;
+        if (!rerun && read_file(p.result_path, text)) {
+            p.kv = parse_kv(text);
+            p.source = "cached";
+            cached++;
+            continue;
+        }
+        if (!binaries.count(tag)) {
+            binaries[tag] = true;
+            if (!exists(p.binary)) {
+                job b;
+                b.kind = job::BUILD;
+                b.argv = { cxx };
+                b.argv.insert(b.argv.end(), flags.begin(), flags.end());
+                b.argv.push_back("-DDSE_DATA_WIDTH=" + std::to_string(p.v[0]));
+                b.argv.push_back("-DDSE_MAC_ROWS=" + std::to_string(p.v[2]));
+                b.argv.push_back("-DDSE_MAC_COLS=" + std::to_string(p.v[3]));
+                b.argv.push_back("dse_point.cpp");
+                b.argv.push_back("-o");
+                b.argv.push_back(p.binary);
+                b.out_path = p.binary;
+                b.log_path = p.binary + ".log";
+                build_job[tag] = sched.add(b);
+            }
+        }
+        job e;
+        e.kind = job::EVAL;
+        e.argv = { p.binary, "workload=" + p.workload, "vector_width=" + std::to_string(p.v[1]),
+                   "cache_size=" + std::to_string(p.v[4]),
+                   "associativity=" + std::to_string(p.v[5]), "fifo_depth=" + std::to_string(p.v[6]),
+                   "route_entries=" + std::to_string(p.v[7]), "line_size=" + std::to_string(p.v[8]),
+                   "miss_cycles=" + std::to_string(p.v[9]) };
+        e.out_path = p.result_path;
+        e.dep = build_job.count(tag) ? build_job[tag] : -1;
+        e.cost = estimate_cost(p);
+        e.point = (int)i;
+        sched.add(e);
+    }
+    const size_t builds = build_job.size();
+    const size_t evals = sched.all().size() - builds;
+    std::cout << "Evaluator sources " << src_tag << ": " << cached << " points cached, " << builds
+              << " builds and " << evals << " evaluations to run on " << jobs << " processes" << std::endl;
+
+    if (dry_run) {
+        for (const job& j : sched.all()) {
+            std::cout << "  " << (j.dep >= 0 ? "  " : "");
+            for (const std::string& a : j.argv) std::cout << a << " ";
+            std::cout << std::endl;
+        }
+        return 0;
+    }
+
+    // ========================================
+    // Run
+    // ========================================
+    auto t0 = std::chrono::steady_clock::now();
+    size_t done = 0, failed = 0;
+    double eval_seconds = 0.0;
+    const size_t total = sched.all().size();
+    sched.run([&](int idx) {
+        const job& j = sched.all()[idx];
+        done++;
+        const bool ok = j.state == job::DONE;
+        if (!ok) failed++;
+        std::string what;
+        if (j.kind == job::BUILD) {
+            what = "build " + j.out_path.substr(j.out_path.rfind('/') + 1);
+            if (!ok) what += " (see " + j.log_path + ")";
+        } else {
+            point& p = pts[j.point];
+            eval_seconds += j.seconds;
+            std::string text;
+            if (ok && read_file(p.result_path, text)) p.kv = parse_kv(text);
+            p.source = ok ? "ran" : "failed";
+            what = "eval  " + pe_tag(p.v) + " c" + std::to_string(p.v[4] / 1024) + "K w" +
+                   std::to_string(p.v[5]) + " f" + std::to_string(p.v[6]) + " rt" + std::to_string(p.v[7]) + " " +
+                   p.workload;
+        }
+        const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        const double eta = done < total ? elapsed / done * (total - done) : 0.0;
+        std::cout << "[" << std::setw(5) << done << "/" << total << "] " << std::left << std::setw(60) << what
+                  << std::right << std::fixed << std::setprecision(2) << std::setw(8) << j.seconds << " s  "
+                  << (ok ? "ok  " : "FAIL") << "  eta " << std::setprecision(0) << eta << " s"
+                  << std::defaultfloat << std::endl;
+    });
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    // ========================================
+    // Fronts
+    // ========================================
+    size_t mismatched = 0;
+    for (point& p : pts) {
+        p.ok = p.kv.count("check") && p.kv["check"] == "ok";
+        if (p.kv.count("check") && !p.ok) mismatched++;
+    }
+    for (const std::string& wl : g.workloads) {
+        mark_fronts(pts, wl);
+        size_t n3 = 0;
+        for (const point& p : pts) n3 += p.workload == wl && p.front3;
+        std::cout << "\n--- " << wl << ": " << n3 << " points on the throughput/area/energy front ---";
+        print_front(pts, wl, true);
+        print_front(pts, wl, false);
+    }
+
+    const bool wrote = write_csv(out_path, pts);
+    std::cout << "\n--- Summary ---" << std::endl;
+    std::cout << std::fixed << std::setprecision(1)
+              << "  points           : " << pts.size() << " (" << cached << " cached, " << evals << " run)" << std::endl
+              << "  builds           : " << builds << std::endl
+              << "  wall time        : " << wall << " s on " << jobs << " processes" << std::endl
+              << "  evaluation time  : " << eval_seconds << " s summed, "
+              << (evals ? eval_seconds / evals : 0.0) << " s per point" << std::endl
+              << "  results          : " << out_path << (wrote ? "" : " (write FAILED)") << std::endl
+              << std::defaultfloat;
+
+    std::cout << "\n========================================" << std::endl;
+    if (failed == 0 && mismatched == 0 && wrote) {
+        std::cout << "SUCCESS: All " << pts.size() << " design points evaluated and checked!" << std::endl;
+    } else {
+        std::cout << "FAILURE: " << failed << " jobs failed, " << mismatched
+                  << " points with result mismatches!" << std::endl;
+    }
+    std::cout << "========================================" << std::endl;
+    return failed == 0 && mismatched == 0 && wrote ? 0 : 1;
+}
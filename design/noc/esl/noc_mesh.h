@@ -0,0 +1,278 @@
+// NoC Mesh Model (ESL)
+// Cycle-level wormhole mesh of 5-port routers with pluggable routing
+//
+// Generalizes mesh_router.v to any COLS x ROWS mesh. Each router has one
+// input buffer of buf_depth flits per port (single virtual channel) and
+// credit-based flow control towards its neighbours. In one cycle a router:
+//
+//   1. Allocates outputs to head flits. route_ports() gives the candidates;
+//      among those not held by another packet, the one with the most
+//      downstream credits wins (ties: the dimension with more hops left).
+//      Inputs are served round-robin.
+//   2. Moves one flit from each allocated input to its output if the
+//      downstream buffer has a credit. The tail flit releases the output.
+//
+// A flit reaches the next router's buffer, and a freed slot returns its
+// credit, at the end of the cycle: one cycle per hop. The local output
+// always accepts (the core sinks one flit per cycle). Each node has an
+// unbounded source queue that injects one flit per cycle, so packet latency
+// includes source queueing, which is what grows without bound past
+// saturation. No SystemC dependency.
+
+#ifndef NOC_MESH_H
+#define NOC_MESH_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <string>
+#include <vector>
+#include <ostream>
+
+#include "noc_routing.h"
+
+struct noc_config {
+    int cols = 8;                   // mesh_router.v CORES_X
+    int rows = 8;                   // mesh_router.v CORES_Y
+    int buf_depth = 4;              // Flits per input buffer
+    noc_algo algo = ALGO_XY;
+
+    bool valid(std::string* err) const {
+        if (cols < 1 || rows < 1 || cols * rows > (1 << 16))
+            return fail("cols and rows must be positive, at most 65536 nodes", err);
+        if (buf_depth < 2)
+            return fail("buf_depth must be at least 2 (one credit round trip)", err);
+        return true;
+    }
+
+    void report(std::ostream& os) const {
+        os << "mesh=" << cols << "x" << rows << " buf_depth=" << buf_depth
+           << " algo=" << algo_name(algo) << std::endl;
+    }
+
+private:
+    static bool fail(const char* msg, std::string* err) {
+        if (err) *err = msg;
+        return false;
+    }
+};
+
+struct noc_packet {
+    int src;
+    int dst;
+    int flits;
+    int tag;                        // Caller-defined (traffic generators use it for the transaction)
+    uint64_t created;               // Cycle send() was called
+    uint64_t done;                  // Cycle the tail flit was ejected, 0 while in flight
+};
+
+class noc_mesh {
+public:
+    explicit noc_mesh(const noc_config& cfg) : cfg(cfg), n(cfg.cols * cfg.rows) {
+        const size_t slots = (size_t)n * NUM_PORTS;
+        buf.assign(slots * cfg.buf_depth, 0);
+        head.assign(slots, 0);
+        count.assign(slots, 0);
+        in_out.assign(slots, -1);
+        out_owner.assign(slots, -1);
+        credits.assign(slots, cfg.buf_depth);
+        link_flits.assign(slots, 0);
+        occupancy.assign(n, 0);
+        rr.assign(n, 0);
+        neighbor.assign(slots, -1);
+        for (int r = 0; r < n; r++) {
+            const int x = r % cfg.cols, y = r / cfg.cols;
+            if (y + 1 < cfg.rows) neighbor[r * NUM_PORTS + PORT_NORTH] = r + cfg.cols;
+            if (x + 1 < cfg.cols) neighbor[r * NUM_PORTS + PORT_EAST] = r + 1;
+            if (y > 0) neighbor[r * NUM_PORTS + PORT_SOUTH] = r - cfg.cols;
+            if (x > 0) neighbor[r * NUM_PORTS + PORT_WEST] = r - 1;
+        }
+        src_queue.resize(n);
+        src_sent.assign(n, 0);
+    }
+
+    int nodes() const { return n; }
+    int node(int x, int y) const { return y * cfg.cols + x; }
+    int x_of(int id) const { return id % cfg.cols; }
+    int y_of(int id) const { return id / cfg.cols; }
+    const noc_config& config() const { return cfg; }
+
+    // Queues a packet at src; returns its id
+    int send(int src, int dst, int flits, int tag = 0) {
+        const int id = (int)packets.size();
+        packets.push_back(noc_packet{ src, dst, flits < 1 ? 1 : flits, tag, now, 0 });
+        src_queue[src].push_back(id);
+        pending++;
+        return id;
+    }
+
+    void step() {
+        ejected.clear();
+        for (int r = 0; r < n; r++)
+            if (occupancy[r]) route_router(r);
+
+        // End of cycle: flits land downstream, freed slots return credits
+        for (const arrival& a : arrivals) push(a.slot, a.flit);
+        arrivals.clear();
+        for (int slot : credit_returns) credits[slot]++;
+        credit_returns.clear();
+
+        // Network interfaces inject one flit per cycle into the local input buffer
+        for (int r = 0; r < n; r++) {
+            if (src_queue[r].empty()) continue;
+            const int slot = r * NUM_PORTS + PORT_LOCAL;
+            if (count[slot] >= cfg.buf_depth) continue;
+            const int id = src_queue[r].front();
+            const int seq = src_sent[r]++;
+            const int flits = packets[id].flits;
+            push(slot, make_flit(id, seq == 0, seq == flits - 1));
+            if (seq == flits - 1) {
+                src_queue[r].pop_front();
+                src_sent[r] = 0;
+            }
+        }
+        now++;
+    }
+
+    uint64_t cycle() const { return now; }
+    size_t in_flight() const { return pending; }
+    size_t packet_count() const { return packets.size(); }
+    const noc_packet& packet(int id) const { return packets[id]; }
+    // Packets whose tail flit was ejected during the last step()
+    const std::vector<int>& delivered() const { return ejected; }
+
+    uint64_t flits_ejected() const { return ejected_flits; }
+    // Flits sent on the link leaving router r by port p
+    uint64_t link_load(int r, int p) const { return link_flits[(size_t)r * NUM_PORTS + p]; }
+    uint64_t max_link_load() const {
+        uint64_t m = 0;
+        for (int r = 0; r < n; r++)
+            for (int p = PORT_NORTH; p < NUM_PORTS; p++) m = std::max(m, link_load(r, p));
+        return m;
+    }
+    void reset_stats() {
+        ejected_flits = 0;
+        std::fill(link_flits.begin(), link_flits.end(), 0);
+    }
+
+private:
+    // Flit: packet id << 2 | head << 1 | tail
+    static uint32_t make_flit(int id, bool is_head, bool is_tail) {
+        return ((uint32_t)id << 2) | (is_head ? 2u : 0u) | (is_tail ? 1u : 0u);
+    }
+    static int flit_packet(uint32_t f) { return (int)(f >> 2); }
+    static bool flit_head(uint32_t f) { return (f & 2u) != 0; }
+    static bool flit_tail(uint32_t f) { return (f & 1u) != 0; }
+
+    struct arrival {
+        int slot;
+        uint32_t flit;
+    };
+
+    void push(int slot, uint32_t flit) {
+        const int pos = (head[slot] + count[slot]) % cfg.buf_depth;
+        buf[(size_t)slot * cfg.buf_depth + pos] = flit;
+        count[slot]++;
+        occupancy[slot / NUM_PORTS]++;
+    }
+
+    uint32_t front(int slot) const { return buf[(size_t)slot * cfg.buf_depth + head[slot]]; }
+
+    void pop(int slot) {
+        head[slot] = (head[slot] + 1) % cfg.buf_depth;
+        count[slot]--;
+        occupancy[slot / NUM_PORTS]--;
+    }
+
+    // Picks an output for the head flit of pk at router r, -1 if every candidate is held
+    int select_output(int r, const noc_packet& pk) const {
+        const int cx = x_of(r), cy = y_of(r);
+        const int dx = x_of(pk.dst), dy = y_of(pk.dst);
+        const unsigned cand = route_ports(cfg.algo, cx, cy, x_of(pk.src), dx, dy);
+        int best = -1, best_credits = -1, best_left = -1;
+        for (int o = 0; o < NUM_PORTS; o++) {
+            if (!(cand & (1u << o)) || out_owner[r * NUM_PORTS + o] >= 0) continue;
+            const int cr = o == PORT_LOCAL ? cfg.buf_depth : credits[r * NUM_PORTS + o];
+            const int left = (o == PORT_EAST || o == PORT_WEST) ? std::abs(dx - cx) : std::abs(dy - cy);
+            if (cr > best_credits || (cr == best_credits && left > best_left)) {
+                best = o;
+                best_credits = cr;
+                best_left = left;
+            }
+        }
+        return best;
+    }
+
+    void route_router(int r) {
+        const int base = r * NUM_PORTS;
+
+        // Output allocation, round-robin over inputs
+        for (int k = 0; k < NUM_PORTS; k++) {
+            const int p = (rr[r] + k) % NUM_PORTS;
+            const int slot = base + p;
+            if (in_out[slot] >= 0 || count[slot] == 0) continue;
+            const int o = select_output(r, packets[flit_packet(front(slot))]);
+            if (o < 0) continue;
+            in_out[slot] = o;
+            out_owner[base + o] = p;
+        }
+        rr[r] = (rr[r] + 1) % NUM_PORTS;
+
+        // Switch traversal: one flit per allocated input
+        for (int p = 0; p < NUM_PORTS; p++) {
+            const int slot = base + p;
+            const int o = in_out[slot];
+            if (o < 0 || count[slot] == 0) continue;
+            const uint32_t f = front(slot);
+            if (o == PORT_LOCAL) {
+                ejected_flits++;
+                if (flit_tail(f)) {
+                    const int id = flit_packet(f);
+                    packets[id].done = now;
+                    ejected.push_back(id);
+                    pending--;
+                }
+            } else {
+                if (credits[base + o] == 0) continue;
+                credits[base + o]--;
+                link_flits[base + o]++;
+                arrivals.push_back(arrival{ neighbor[base + o] * NUM_PORTS + opposite_port(o), f });
+            }
+            pop(slot);
+            // The freed slot is a credit for whoever feeds this input
+            if (p != PORT_LOCAL) credit_returns.push_back(neighbor[slot] * NUM_PORTS + opposite_port(p));
+            if (flit_tail(f)) {
+                in_out[slot] = -1;
+                out_owner[base + o] = -1;
+            }
+        }
+    }
+
+    noc_config cfg;
+    int n;
+    uint64_t now = 0;
+    size_t pending = 0;
+    uint64_t ejected_flits = 0;
+
+    // Per router x port, flattened as r * NUM_PORTS + p
+    std::vector<uint32_t> buf;      // Input buffers, buf_depth flits each
+    std::vector<int> head;
+    std::vector<int> count;
+    std::vector<int> in_out;        // Output an input is locked to, -1 = none
+    std::vector<int> out_owner;     // Input holding an output, -1 = free
+    std::vector<int> credits;       // Free slots in the downstream buffer
+    std::vector<int> neighbor;      // Router behind each port, -1 at the edge
+    std::vector<uint64_t> link_flits;
+    std::vector<int> occupancy;     // Buffered flits per router, to skip idle routers
+    std::vector<int> rr;
+
+    std::vector<std::deque<int>> src_queue;
+    std::vector<int> src_sent;      // Flits of the queue head already injected
+    std::vector<noc_packet> packets;
+    std::vector<arrival> arrivals;
+    std::vector<int> credit_returns;
+    std::vector<int> ejected;
+};
+
+#endif // NOC_MESH_H
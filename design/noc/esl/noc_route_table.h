@@ -0,0 +1,141 @@
+// NoC Route Table (ESL)
+// Address/mask route lookup with router_table.v semantics, sized for thousands of entries
+//
+// An entry matches when ((addr ^ entry.addr) & entry.mask) == 0. The matching
+// entry with the lowest index wins; if none matches, the default target is
+// used. This is the order in router_spec.md section 4.2; note that the
+// router_table.v loop lets the last match win instead. A linear scan is fine
+// for 8 entries, but a 32x32 mesh address map has one region per core plus
+// the memory-port interleave: over a thousand entries.
+//
+// Entries are grouped by mask (tuple space search). Each distinct mask has
+// an open-addressing hash table from (addr & mask) to the best entry index
+// of that group. Groups are probed in order of their best index, and the
+// probe stops once no remaining group can beat the current hit. Address maps
+// use a handful of distinct masks, so a lookup costs a few hash probes
+// whatever the entry count. lookup_linear() is the reference scan.
+// No SystemC dependency.
+
+#ifndef NOC_ROUTE_TABLE_H
+#define NOC_ROUTE_TABLE_H
+
+#include <cstdint>
+#include <climits>
+#include <vector>
+
+struct route_entry {
+    uint32_t addr;
+    uint32_t mask;
+    int target;             // Output port or destination node, as the caller defines
+};
+
+class noc_route_table {
+public:
+    explicit noc_route_table(int default_target = -1) : default_target(default_target) {}
+
+    // Appends an entry (lowest priority so far) and returns its index
+    int add(uint32_t addr, uint32_t mask, int target) {
+        const int idx = (int)entries.size();
+        entries.push_back(route_entry{ addr & mask, mask, target });
+
+        size_t g = 0;
+        while (g < groups.size() && groups[g].mask != mask) g++;
+        if (g == groups.size()) {
+            groups.push_back(group());
+            groups[g].mask = mask;
+            groups[g].best = idx;
+            groups[g].resize(16);
+        }
+        group& grp = groups[g];
+        if (2 * (grp.used + 1) > grp.vals.size()) grp.resize(grp.vals.size() * 2);
+        grp.insert(addr & mask, idx);      // An earlier entry with the same key keeps priority
+        return idx;
+    }
+
+    void set_default(int target) { default_target = target; }
+    void clear() {
+        entries.clear();
+        groups.clear();
+    }
+
+    size_t size() const { return entries.size(); }
+    size_t group_count() const { return groups.size(); }
+    const route_entry& entry(int idx) const { return entries[idx]; }
+
+    int lookup(uint32_t addr) const {
+        const int idx = lookup_index(addr);
+        return idx < 0 ? default_target : entries[idx].target;
+    }
+
+    // Index of the winning entry, -1 for the default
+    int lookup_index(uint32_t addr) const {
+        int best = INT_MAX;
+        // Groups are created in entry order, so they are sorted by best index
+        for (const group& g : groups) {
+            if (g.best >= best) break;              // Nothing later can win
+            const int idx = g.find(addr & g.mask);
+            if (idx >= 0 && idx < best) best = idx;
+        }
+        return best == INT_MAX ? -1 : best;
+    }
+
+    // Reference: every entry in priority order, as router_table.v compares them
+    int lookup_linear(uint32_t addr) const {
+        for (const route_entry& e : entries)
+            if (((addr ^ e.addr) & e.mask) == 0) return e.target;
+        return default_target;
+    }
+
+private:
+    struct group {
+        uint32_t mask = 0;
+        int best = 0;                   // Lowest entry index in the group
+        size_t used = 0;
+        int bits = 0;
+        std::vector<uint32_t> keys;
+        std::vector<int> vals;          // -1 = empty slot
+
+        size_t slot(uint32_t key) const { return bits ? (size_t)((key * 0x9E3779B1u) >> (32 - bits)) : 0; }
+
+        int find(uint32_t key) const {
+            const size_t m = vals.size() - 1;
+            for (size_t s = slot(key);; s = (s + 1) & m) {
+                if (vals[s] < 0) return -1;
+                if (keys[s] == key) return vals[s];
+            }
+        }
+
+        void insert(uint32_t key, int idx) {
+            const size_t m = vals.size() - 1;
+            for (size_t s = slot(key);; s = (s + 1) & m) {
+                if (vals[s] < 0) {
+                    keys[s] = key;
+                    vals[s] = idx;
+                    used++;
+                    return;
+                }
+                if (keys[s] == key) return;
+            }
+        }
+
+        void resize(size_t n) {
+            std::vector<uint32_t> old_keys;
+            std::vector<int> old_vals;
+            old_keys.swap(keys);
+            old_vals.swap(vals);
+            keys.assign(n, 0);
+            vals.assign(n, -1);
+            used = 0;
+            bits = 0;
+            while (((size_t)1 << bits) < n) bits++;
+            for (size_t s = 0; s < old_vals.size(); s++)
+                if (old_vals[s] >= 0) insert(old_keys[s], old_vals[s]);
+        }
+    };
+
+    std::vector<route_entry> entries;
+    std::vector<group> groups;
+    int default_target;
+};
+
+#endif // NOC_ROUTE_TABLE_H
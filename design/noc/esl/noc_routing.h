@@ -0,0 +1,110 @@
+// NoC Routing Functions (ESL)
+// Dimension-order XY, turn-model west-first and odd-even adaptive routing for a 2-D mesh
+//
+// Each function returns the set of output ports a packet may take from the
+// current router, as a bitmask of (1 << port). All three are minimal and
+// deadlock-free with one virtual channel:
+//
+//   XY          X first, then Y (mesh_router.v). One candidate per hop.
+//   West-first  All west hops first; east/north/south are then adaptive.
+//   Odd-even    Chiu's turn model: no east->north/south turn in an even
+//               column, no north/south->west turn in an odd column. Adaptive
+//               in both directions, more evenly than west-first.
+//
+// North is +y (mesh_router.v: go_north when dest_row > my_y). Columns count
+// from 0, which is even. The selection among candidates is left to the
+// router (noc_mesh picks the output with the most downstream credits).
+// No SystemC dependency.
+
+#ifndef NOC_ROUTING_H
+#define NOC_ROUTING_H
+
+#include <string>
+
+enum noc_port { PORT_LOCAL = 0, PORT_NORTH = 1, PORT_EAST = 2, PORT_SOUTH = 3, PORT_WEST = 4, NUM_PORTS = 5 };
+
+enum noc_algo { ALGO_XY = 0, ALGO_WEST_FIRST = 1, ALGO_ODD_EVEN = 2, NUM_ALGOS = 3 };
+
+inline const char* algo_name(noc_algo a) {
+    static const char* names[] = { "xy", "west_first", "odd_even" };
+    return names[a];
+}
+
+inline bool parse_algo(const std::string& s, noc_algo& a) {
+    for (int i = 0; i < NUM_ALGOS; i++)
+        if (s == algo_name((noc_algo)i)) {
+            a = (noc_algo)i;
+            return true;
+        }
+    return false;
+}
+
+inline const char* port_name(int p) {
+    static const char* names[] = { "L", "N", "E", "S", "W" };
+    return names[p];
+}
+
+inline int opposite_port(int p) {
+    static const int opp[] = { PORT_LOCAL, PORT_SOUTH, PORT_WEST, PORT_NORTH, PORT_EAST };
+    return opp[p];
+}
+
+// Allowed output ports at (cx, cy) for a packet from source column sx to (dx, dy)
+inline unsigned route_ports(noc_algo algo, int cx, int cy, int sx, int dx, int dy) {
+    const int ex = dx - cx, ey = dy - cy;
+    if (ex == 0 && ey == 0) return 1u << PORT_LOCAL;
+    const unsigned vert = ey > 0 ? 1u << PORT_NORTH : (ey < 0 ? 1u << PORT_SOUTH : 0u);
+    const unsigned horiz = ex > 0 ? 1u << PORT_EAST : (ex < 0 ? 1u << PORT_WEST : 0u);
+
+    switch (algo) {
+        case ALGO_XY:
+            return ex != 0 ? horiz : vert;
+
+        case ALGO_WEST_FIRST:
+            if (ex < 0) return horiz;
+            return horiz | vert;
+
+        case ALGO_ODD_EVEN: {
+            if (ex == 0) return vert;
+            unsigned ports = 0;
+            if (ex > 0) {
+                if (ey == 0) return horiz;
+                // Turning north/south from an eastbound hop is only legal in an odd column
+                // (or before the first east hop, in the source column)
+                if ((cx & 1) || cx == sx) ports |= vert;
+                // East only if the north/south turn is still possible later
+                if ((dx & 1) || ex != 1) ports |= horiz;
+            } else {
+                ports = horiz;
+                // A westbound packet may go north/south first only in an even column
+                if (!(cx & 1)) ports |= vert;
+            }
+            return ports;
+        }
+
+        default:
+            return 0;
+    }
+}
+
+// Turn rules, for checking routes: travelling in direction `in` (the port a
+// flit left the previous router by), then leaving by `out` at column cx
+inline bool turn_allowed(noc_algo algo, int in, int out, int cx) {
+    if (in == PORT_LOCAL || out == PORT_LOCAL || in == out) return true;
+    if (out == opposite_port(in)) return false;                 // 180-degree turn
+    const bool in_vert = in == PORT_NORTH || in == PORT_SOUTH;
+    switch (algo) {
+        case ALGO_XY:
+            return !in_vert;                                    // No Y -> X turns
+        case ALGO_WEST_FIRST:
+            return out != PORT_WEST;                            // No turns into west
+        case ALGO_ODD_EVEN:
+            if (in == PORT_EAST && (out == PORT_NORTH || out == PORT_SOUTH)) return (cx & 1) != 0;
+            if (in_vert && out == PORT_WEST) return (cx & 1) == 0;
+            return true;
+        default:
+            return false;
+    }
+}
+
+#endif // NOC_ROUTING_H
@@ -0,0 +1,267 @@
+// NoC Traffic Generators (ESL)
+// Chip address map, GEMM and all-reduce traffic, and load/latency measurement
+//
+// Every packet is addressed the way a core's network interface addresses
+// it: the target address goes through the chip route table (noc_route_table)
+// to find the destination node. The address map has one 64 KB local memory
+// region per core, a host mailbox, and DRAM interleaved by 4 KB page over
+// memory ports on the west and east edge routers. On a 32x32 mesh the map
+// holds over a thousand entries.
+//
+// Patterns (load is offered flits per node per cycle, requests included):
+//
+//   gemm            Distributed output-stationary GEMM (SUMMA). The core at
+//                   (x, y) reads A(y, k) from a core in its row and B(k, x)
+//                   from a core in its column for random k. A quarter of the
+//                   reads go to DRAM instead. A read is a 1-flit request and
+//                   a resp_flits response; latency is the round trip.
+//   allreduce       Recursive halving/doubling, time-averaged. Stage s pairs
+//                   rank r with r ^ (P >> (s + 1)) and carries half the data
+//                   of stage s - 1. Ranks are row-major.
+//   allreduce_rand  The same with ranks placed at random, as after a job
+//                   scheduler has fragmented the mesh.
+//   uniform         Uniform random destinations (reference).
+//   transpose       (x, y) -> (y, x), the classic XY-adversarial permutation.
+//
+// No SystemC dependency.
+
+#ifndef NOC_TRAFFIC_H
+#define NOC_TRAFFIC_H
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "noc_mesh.h"
+#include "noc_route_table.h"
+
+enum noc_pattern {
+    PAT_GEMM = 0,
+    PAT_ALLREDUCE = 1,
+    PAT_ALLREDUCE_RAND = 2,
+    PAT_UNIFORM = 3,
+    PAT_TRANSPOSE = 4,
+    NUM_PATTERNS = 5
+};
+
+inline const char* pattern_name(noc_pattern p) {
+    static const char* names[] = { "gemm", "allreduce", "allreduce_rand", "uniform", "transpose" };
+    return names[p];
+}
+
+inline bool parse_pattern(const std::string& s, noc_pattern& p) {
+    for (int i = 0; i < NUM_PATTERNS; i++)
+        if (s == pattern_name((noc_pattern)i)) {
+            p = (noc_pattern)i;
+            return true;
+        }
+    return false;
+}
+
+// ========================================
+// Address map
+// ========================================
+namespace noc_addr {
+    const uint32_t REGION_MASK = 0xFFFF0000;    // 64 KB per core
+    const uint32_t MAILBOX_BASE = 0x7FFF0000;   // Host mailbox, at node 0
+    const uint32_t DRAM_BASE = 0x80000000;
+    const int PAGE_SHIFT = 12;                  // DRAM interleave granule
+
+    inline uint32_t core_base(int id) { return (uint32_t)id << 16; }
+
+    // Memory port nodes: west and east edge routers, alternating by row
+    inline std::vector<int> memory_ports(const noc_mesh& mesh) {
+        const int cols = mesh.config().cols, rows = mesh.config().rows;
+        std::vector<int> ports;
+        for (int y = 0; y < rows; y++) {
+            ports.push_back(mesh.node(0, y));
+            if (cols > 1) ports.push_back(mesh.node(cols - 1, y));
+        }
+        // Mask interleave needs a power of two
+        size_t m = 1;
+        while (m * 2 <= ports.size()) m *= 2;
+        ports.resize(m);
+        return ports;
+    }
+
+    // Mailbox first, then the core regions, then one entry per DRAM port
+    inline void build_map(noc_route_table& table, const noc_mesh& mesh) {
+        table.clear();
+        table.set_default(-1);
+        table.add(MAILBOX_BASE, REGION_MASK, 0);
+        for (int id = 0; id < mesh.nodes(); id++) table.add(core_base(id), REGION_MASK, id);
+        const std::vector<int> ports = memory_ports(mesh);
+        const uint32_t sel = (uint32_t)(ports.size() - 1) << PAGE_SHIFT;
+        for (size_t i = 0; i < ports.size(); i++)
+            table.add(DRAM_BASE | ((uint32_t)i << PAGE_SHIFT), DRAM_BASE | sel, ports[i]);
+    }
+}
+
+// ========================================
+// Traffic generator
+// ========================================
+struct noc_load_result {
+    double offered = 0;             // Flits per node per cycle generated in the window
+    double accepted = 0;            // Flits per node per cycle ejected in the window
+    double mean_latency = 0;
+    double p50 = 0, p99 = 0, p999 = 0, max_latency = 0;
+    double max_link_util = 0;       // Busiest link, flits per cycle
+    size_t samples = 0;
+    bool drained = false;           // Every packet from the window was delivered
+};
+
+class noc_traffic {
+public:
+    int resp_flits = 8;             // 64 B line on 64-bit flits (mesh_router.v DATA_W)
+    int data_flits = 8;             // All-reduce, uniform and transpose packets
+    double dram_fraction = 0.25;    // Share of GEMM reads that go to DRAM
+
+    noc_traffic(noc_mesh& mesh, noc_pattern pat, double rate, uint32_t seed = 1)
+        : mesh(mesh), pat(pat), rate(rate), rng(seed ? seed : 1) {
+        noc_addr::build_map(table, mesh);
+        const int n = mesh.nodes();
+        rank_node.resize(n);
+        std::iota(rank_node.begin(), rank_node.end(), 0);
+        if (pat == PAT_ALLREDUCE_RAND)
+            for (int i = n - 1; i > 0; i--) std::swap(rank_node[i], rank_node[next() % (i + 1)]);
+        node_rank.resize(n);
+        for (int r = 0; r < n; r++) node_rank[rank_node[r]] = r;
+        stages = 0;
+        while ((1 << (stages + 1)) <= n) stages++;
+    }
+
+    const noc_route_table& route_table() const { return table; }
+    // 0 stops new transactions; GEMM responses to requests in flight are still sent
+    void set_rate(double r) { rate = r; }
+
+    // Transactions created in [begin, end) are measured
+    void set_window(uint64_t begin, uint64_t end) {
+        win_begin = begin;
+        win_end = end;
+    }
+
+    // Handles last cycle's deliveries, generates this cycle's packets, steps the mesh
+    void step() {
+        const uint64_t now = mesh.cycle();
+        for (int id : mesh.delivered()) {
+            const noc_packet& pk = mesh.packet(id);
+            const int txn = pk.tag >> 1;
+            if (pat == PAT_GEMM && !(pk.tag & 1)) {
+                // Read request arrived: the owner returns the data
+                mesh.send(pk.dst, pk.src, resp_flits, (txn << 1) | 1);
+                continue;
+            }
+            const uint64_t created = txn_created[txn];
+            if (created >= win_begin && created < win_end) {
+                latencies.push_back((uint32_t)(now - created));
+                outstanding--;
+            }
+        }
+
+        const bool measure = now >= win_begin && now < win_end;
+        const int flits = pat == PAT_GEMM ? 1 + resp_flits : data_flits;
+        const uint32_t threshold = (uint32_t)std::min(4294967295.0, rate / flits * 4294967296.0);
+        for (int src = 0; src < mesh.nodes(); src++) {
+            if (next() >= threshold) continue;
+            const uint32_t addr = target_address(src);
+            const int dst = table.lookup(addr);
+            if (dst < 0 || dst == src) continue;
+            const int txn = (int)txn_created.size();
+            txn_created.push_back(now);
+            mesh.send(src, dst, pat == PAT_GEMM ? 1 : data_flits, txn << 1);
+            if (measure) {
+                offered_flits += flits;
+                outstanding++;
+            }
+        }
+        if (now == win_begin) mesh.reset_stats();
+        if (now == win_end) {
+            window_ejected = mesh.flits_ejected();
+            window_max_link = mesh.max_link_load();
+        }
+        mesh.step();
+    }
+
+    // Runs warmup + window + drain and summarizes the window
+    noc_load_result run(uint64_t warmup, uint64_t window, uint64_t max_drain) {
+        set_window(mesh.cycle() + warmup, mesh.cycle() + warmup + window);
+        while (mesh.cycle() < win_end) step();
+        step();     // Latches the window counters
+        for (uint64_t c = 0; c < max_drain && outstanding > 0; c++) step();
+
+        noc_load_result res;
+        const double node_cycles = (double)mesh.nodes() * window;
+        res.offered = offered_flits / node_cycles;
+        res.accepted = window_ejected / node_cycles;
+        res.max_link_util = (double)window_max_link / window;
+        res.drained = outstanding == 0;
+        res.samples = latencies.size();
+        if (!latencies.empty()) {
+            std::vector<uint32_t> lat(latencies);
+            std::sort(lat.begin(), lat.end());
+            const auto pct = [&](double q) { return (double)lat[std::min(lat.size() - 1, (size_t)(q * lat.size()))]; };
+            res.mean_latency = std::accumulate(lat.begin(), lat.end(), 0.0) / lat.size();
+            res.p50 = pct(0.50);
+            res.p99 = pct(0.99);
+            res.p999 = pct(0.999);
+            res.max_latency = lat.back();
+        }
+        return res;
+    }
+
+private:
+    uint32_t next() {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return rng;
+    }
+
+    uint32_t core_address(int id) { return noc_addr::core_base(id) | (next() & 0xFFC0); }
+
+    uint32_t target_address(int src) {
+        const int cols = mesh.config().cols, rows = mesh.config().rows;
+        const int x = mesh.x_of(src), y = mesh.y_of(src);
+        switch (pat) {
+            case PAT_GEMM: {
+                if ((next() >> 8) < (uint32_t)(dram_fraction * 16777216.0))
+                    return noc_addr::DRAM_BASE | (next() & 0x3FFFFFC0);
+                // A(y, k) lives in row y, B(k, x) in column x
+                if (next() & 1) return core_address(mesh.node(next() % cols, y));
+                return core_address(mesh.node(x, next() % rows));
+            }
+            case PAT_ALLREDUCE:
+            case PAT_ALLREDUCE_RAND: {
+                // Stage s carries 2^-(s+1) of the data
+                int s = 0;
+                while (s + 1 < stages && (next() & 1)) s++;
+                const int partner = node_rank[src] ^ (1 << (stages - 1 - s));
+                return core_address(rank_node[partner]);
+            }
+            case PAT_TRANSPOSE:
+                return y < cols && x < rows ? core_address(mesh.node(y, x)) : core_address(src);
+            case PAT_UNIFORM:
+            default:
+                return core_address(next() % mesh.nodes());
+        }
+    }
+
+    noc_mesh& mesh;
+    noc_pattern pat;
+    double rate;
+    uint32_t rng;
+    noc_route_table table;
+    std::vector<int> rank_node, node_rank;
+    int stages;
+
+    std::vector<uint64_t> txn_created;
+    std::vector<uint32_t> latencies;
+    uint64_t win_begin = 0, win_end = 0;
+    uint64_t offered_flits = 0;
+    uint64_t window_ejected = 0, window_max_link = 0;
+    size_t outstanding = 0;
+};
+
+#endif // NOC_TRAFFIC_H
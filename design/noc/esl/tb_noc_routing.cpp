@@ -0,0 +1,395 @@
+// NoC Routing Engine Testbench
+// Route table lookup, routing legality and a saturation / tail-latency study
+//
+// 1. Route table: the grouped lookup must return what the router_table.v
+//    linear scan returns, on a random 4096-entry table and on the 32x32 chip
+//    address map. Both are timed against the scan; the speedup is printed
+//    but not checked, since it depends on the host.
+// 2. Routing functions: on every source/destination pair, each candidate
+//    port must be minimal and obey the algorithm's turn rules.
+// 3. Deadlock: each algorithm is overloaded with transpose and uniform
+//    traffic, then injection stops and the mesh must drain.
+// 4. Study: saturation throughput and tail latency per mesh size, traffic
+//    pattern and routing algorithm. Tail latency is taken at 50% and 90% of
+//    the XY saturation load, so all algorithms carry the same traffic.
+//
+// Arguments (key=value): sizes=8 patterns=gemm,allreduce,allreduce_rand
+// cycles=3000 (measurement window). The default is the 8x8 study only, so a
+// plain run is a quick functional test; sizes=8,16,32 is the full study.
+// No SystemC dependency.
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include "noc_route_table.h"
+#include "noc_routing.h"
+#include "noc_mesh.h"
+#include "noc_traffic.h"
+
+static int failed = 0;
+
+static void check(bool cond, const std::string& what) {
+    std::cout << "  " << std::left << std::setw(60) << what << (cond ? "ok" : "FAIL") << std::right << std::endl;
+    if (!cond) failed++;
+}
+
+static uint32_t lcg(uint32_t& seed) {
+    seed = seed * 1664525u + 1013904223u;
+    return seed;
+}
+
+static std::vector<std::string> split(const std::string& s) {
+    std::vector<std::string> out;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ',')) if (!item.empty()) out.push_back(item);
+    return out;
+}
+
+// ========================================
+// 1. Route table
+// ========================================
+template <typename F>
+static double lookups_per_sec(F lookup, const std::vector<uint32_t>& addrs) {
+    uint64_t sink = 0, n = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    double secs = 0.0;
+    do {
+        for (uint32_t a : addrs) sink += (uint32_t)lookup(a);
+        n += addrs.size();
+        secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    } while (secs < 0.2);
+    if (sink == 1) std::cout << "";     // Keep the loop
+    return n / secs;
+}
+
+static void test_route_table() {
+    std::cout << "\n--- Route table ---" << std::endl;
+
+    // Regions of 64 KB, 4 KB and 64 B, as in a page-granular address map
+    const uint32_t masks[] = { 0xFFFF0000, 0xFFFFF000, 0xFFFFFFC0 };
+    uint32_t seed = 2024;
+    noc_route_table table(7);
+    std::vector<uint32_t> hits;
+    for (int i = 0; i < 4096; i++) {
+        const uint32_t mask = masks[lcg(seed) % 3];
+        const uint32_t addr = lcg(seed);
+        table.add(addr, mask, (int)(lcg(seed) % 1024));
+        hits.push_back(addr ^ (lcg(seed) & ~mask));
+    }
+    // Half hits on random entries, half random addresses (mostly misses)
+    std::vector<uint32_t> addrs;
+    for (int i = 0; i < 65536; i++) addrs.push_back(i & 1 ? hits[lcg(seed) % hits.size()] : lcg(seed));
+
+    size_t mismatches = 0;
+    for (uint32_t a : addrs)
+        if (table.lookup(a) != table.lookup_linear(a)) mismatches++;
+    check(mismatches == 0, "4096 entries: grouped lookup == linear scan (65536 addresses)");
+
+    // Priority: an earlier, wider entry shadows a later, narrower one
+    noc_route_table prio(-1);
+    prio.add(0x10000000, 0xF0000000, 1);
+    prio.add(0x12340000, 0xFFFF0000, 2);
+    prio.add(0x20000000, 0xFFFF0000, 3);
+    prio.add(0x20000000, 0xF0000000, 4);
+    check(prio.lookup(0x12345678) == 1 && prio.lookup(0x20001234) == 3 &&
+          prio.lookup(0x2F000000) == 4 && prio.lookup(0x30000000) == -1,
+          "lowest index wins, default on a miss");
+
+    // 32x32 chip address map
+    noc_config cfg;
+    cfg.cols = cfg.rows = 32;
+    noc_mesh mesh(cfg);
+    noc_route_table chip;
+    noc_addr::build_map(chip, mesh);
+    bool map_ok = chip.lookup(noc_addr::MAILBOX_BASE + 0x40) == 0;
+    for (int id = 0; id < mesh.nodes(); id++)
+        map_ok = map_ok && chip.lookup(noc_addr::core_base(id) + 0x1234) == id;
+    const std::vector<int> ports = noc_addr::memory_ports(mesh);
+    for (size_t p = 0; p < 4 * ports.size(); p++) {
+        const uint32_t a = noc_addr::DRAM_BASE + (uint32_t)(p << noc_addr::PAGE_SHIFT) + 0x80;
+        map_ok = map_ok && chip.lookup(a) == ports[p % ports.size()];
+    }
+    std::ostringstream what;
+    what << "32x32 map: " << chip.size() << " entries in " << chip.group_count() << " groups, every region resolves";
+    check(map_ok, what.str());
+
+    const double lin = lookups_per_sec([&](uint32_t a) { return table.lookup_linear(a); }, addrs);
+    const double grp = lookups_per_sec([&](uint32_t a) { return table.lookup(a); }, addrs);
+    std::cout << "  4096 entries: linear " << std::fixed << std::setprecision(2) << lin / 1e6
+              << " Mlookup/s, grouped " << grp / 1e6 << " Mlookup/s ("
+              << std::setprecision(0) << grp / lin << "x)" << std::endl;
+
+    std::vector<uint32_t> chip_addrs;
+    for (int i = 0; i < 65536; i++)
+        chip_addrs.push_back(i & 1 ? noc_addr::DRAM_BASE | (lcg(seed) >> 1) : noc_addr::core_base(lcg(seed) % 1024) | (lcg(seed) & 0xFFFF));
+    const double chip_lin = lookups_per_sec([&](uint32_t a) { return chip.lookup_linear(a); }, chip_addrs);
+    const double chip_grp = lookups_per_sec([&](uint32_t a) { return chip.lookup(a); }, chip_addrs);
+    std::cout << "  32x32 map:    linear " << std::setprecision(2) << chip_lin / 1e6
+              << " Mlookup/s, grouped " << chip_grp / 1e6 << " Mlookup/s ("
+              << std::setprecision(0) << chip_grp / chip_lin << "x)" << std::endl;
+}
+
+// ========================================
+// 2. Routing functions
+// ========================================
+// Walks every state (router, arrival direction) reachable from src and checks
+// each candidate: non-empty, minimal and turn-legal
+static bool check_pair(noc_algo algo, int cols, int rows, int src, int dst) {
+    const int sx = src % cols, dx = dst % cols, dy = dst / cols;
+    std::vector<char> seen((size_t)cols * rows * NUM_PORTS, 0);
+    std::vector<std::pair<int, int>> work{ { src, PORT_LOCAL } };
+    seen[(size_t)src * NUM_PORTS] = 1;
+    while (!work.empty()) {
+        const int r = work.back().first, in = work.back().second;
+        work.pop_back();
+        const int cx = r % cols, cy = r / cols;
+        const unsigned cand = route_ports(algo, cx, cy, sx, dx, dy);
+        if (cand == 0) return false;
+        if (r == dst) {
+            if (cand != (1u << PORT_LOCAL)) return false;
+            continue;
+        }
+        for (int o = PORT_NORTH; o < NUM_PORTS; o++) {
+            if (!(cand & (1u << o))) continue;
+            if (!turn_allowed(algo, in, o, cx)) return false;
+            int nx = cx, ny = cy;
+            if (o == PORT_NORTH) ny++;
+            if (o == PORT_SOUTH) ny--;
+            if (o == PORT_EAST) nx++;
+            if (o == PORT_WEST) nx--;
+            if (nx < 0 || nx >= cols || ny < 0 || ny >= rows) return false;
+            if (std::abs(dx - nx) + std::abs(dy - ny) >= std::abs(dx - cx) + std::abs(dy - cy)) return false;
+            const int nr = ny * cols + nx;
+            if (!seen[(size_t)nr * NUM_PORTS + o]) {
+                seen[(size_t)nr * NUM_PORTS + o] = 1;
+                work.push_back({ nr, o });
+            }
+        }
+    }
+    return true;
+}
+
+static void test_routing_functions() {
+    std::cout << "\n--- Routing functions ---" << std::endl;
+    const int shapes[][2] = { { 8, 8 }, { 7, 5 } };
+    for (int a = 0; a < NUM_ALGOS; a++) {
+        for (const auto& s : shapes) {
+            const int n = s[0] * s[1];
+            int bad = 0;
+            for (int src = 0; src < n; src++)
+                for (int dst = 0; dst < n; dst++)
+                    if (!check_pair((noc_algo)a, s[0], s[1], src, dst)) bad++;
+            std::ostringstream what;
+            what << algo_name((noc_algo)a) << " " << s[0] << "x" << s[1] << ": minimal and turn-legal on all pairs";
+            check(bad == 0, what.str());
+        }
+    }
+
+    // XY is mesh_router.v: X until the column matches, then Y
+    bool xy_ok = route_ports(ALGO_XY, 2, 2, 2, 5, 6) == (1u << PORT_EAST) &&
+                 route_ports(ALGO_XY, 5, 2, 2, 5, 6) == (1u << PORT_NORTH) &&
+                 route_ports(ALGO_XY, 5, 6, 2, 1, 0) == (1u << PORT_WEST);
+    check(xy_ok, "xy matches mesh_router.v dimension order");
+    // The adaptive algorithms must actually offer a choice
+    check(route_ports(ALGO_WEST_FIRST, 2, 2, 2, 5, 6) == ((1u << PORT_EAST) | (1u << PORT_NORTH)) &&
+          route_ports(ALGO_ODD_EVEN, 4, 6, 4, 1, 0) == ((1u << PORT_WEST) | (1u << PORT_SOUTH)),
+          "west_first and odd_even are adaptive");
+}
+
+// ========================================
+// 3. Deadlock
+// ========================================
+static void test_drain() {
+    std::cout << "\n--- Drain after overload ---" << std::endl;
+    for (int a = 0; a < NUM_ALGOS; a++) {
+        for (noc_pattern pat : { PAT_TRANSPOSE, PAT_UNIFORM }) {
+            noc_config cfg;
+            cfg.algo = (noc_algo)a;
+            noc_mesh mesh(cfg);
+            noc_traffic traffic(mesh, pat, 0.8, 11);
+            for (int c = 0; c < 3000; c++) traffic.step();
+            traffic.set_rate(0.0);
+            const size_t queued = mesh.in_flight();
+            int c = 0;
+            for (; c < 200000 && mesh.in_flight() > 0; c++) traffic.step();
+            std::ostringstream what;
+            what << algo_name((noc_algo)a) << " " << pattern_name(pat) << ": " << queued
+                 << " packets drained in " << c << " cycles";
+            check(mesh.in_flight() == 0, what.str());
+        }
+    }
+}
+
+// ========================================
+// 4. Study
+// ========================================
+struct study_args {
+    int cycles = 3000;
+};
+
+static noc_load_result measure(int size, noc_algo algo, noc_pattern pat, double rate, const study_args& args) {
+    noc_config cfg;
+    cfg.cols = cfg.rows = size;
+    cfg.algo = algo;
+    noc_mesh mesh(cfg);
+    noc_traffic traffic(mesh, pat, rate, 1234 + size);
+    return traffic.run(args.cycles / 3, args.cycles, 3 * args.cycles);
+}
+
+static bool saturated(const noc_load_result& r, double zero_load) {
+    return !r.drained || r.accepted < 0.95 * r.offered || r.mean_latency > 3.0 * zero_load;
+}
+
+struct study_point {
+    double zero_load = 0;
+    double sat_rate = 0;            // Highest unsaturated injection rate found
+    double sat_accepted = 0;        // Flits/node/cycle delivered there
+    noc_load_result at50, at90;
+    bool ok50 = false, ok90 = false;
+};
+
+// Doubles the rate until saturation, then bisects to 3%
+static void find_saturation(int size, noc_algo algo, noc_pattern pat, const study_args& args, study_point& pt) {
+    pt.zero_load = measure(size, algo, pat, 0.005, args).mean_latency;
+    double lo = 0.0, hi = 0.02;
+    noc_load_result best;
+    for (;;) {
+        const noc_load_result r = measure(size, algo, pat, hi, args);
+        if (saturated(r, pt.zero_load)) break;
+        lo = hi;
+        best = r;
+        if (hi >= 1.0) break;
+        hi = std::min(1.0, hi * 2);
+    }
+    while (hi - lo > 0.03 * hi) {
+        const double mid = 0.5 * (lo + hi);
+        const noc_load_result r = measure(size, algo, pat, mid, args);
+        if (saturated(r, pt.zero_load)) {
+            hi = mid;
+        } else {
+            lo = mid;
+            best = r;
+        }
+    }
+    pt.sat_rate = lo;
+    pt.sat_accepted = best.accepted;
+}
+
+static std::string latency_cell(bool ok, double v) {
+    std::ostringstream s;
+    if (ok) s << std::fixed << std::setprecision(0) << v;
+    else s << "sat";
+    return s.str();
+}
+
+static void run_study(const std::vector<int>& sizes, const std::vector<noc_pattern>& patterns, const study_args& args) {
+    for (int size : sizes) {
+        noc_config cfg;
+        cfg.cols = cfg.rows = size;
+        noc_mesh probe(cfg);
+        noc_route_table map;
+        noc_addr::build_map(map, probe);
+        std::cout << "\n--- Mesh " << size << "x" << size << " (" << probe.nodes() << " nodes, "
+                  << noc_addr::memory_ports(probe).size() << " memory ports, " << map.size()
+                  << " route entries) ---" << std::endl;
+        std::cout << std::left << std::setw(16) << "Pattern" << std::setw(12) << "Algo" << std::right
+                  << std::setw(10) << "Zero-load" << std::setw(10) << "Sat.rate" << std::setw(10) << "Accepted"
+                  << std::setw(9) << "vs XY" << std::setw(9) << "p99@50" << std::setw(10) << "p99.9@50"
+                  << std::setw(9) << "p99@90" << std::setw(10) << "p99.9@90" << std::endl;
+
+        const auto t0 = std::chrono::steady_clock::now();
+        for (noc_pattern pat : patterns) {
+            study_point pts[NUM_ALGOS];
+            for (int a = 0; a < NUM_ALGOS; a++) find_saturation(size, (noc_algo)a, pat, args, pts[a]);
+            // Tail latency at the same absolute loads for every algorithm
+            const double xy_sat = pts[ALGO_XY].sat_rate;
+            for (int a = 0; a < NUM_ALGOS; a++) {
+                study_point& pt = pts[a];
+                pt.at50 = measure(size, (noc_algo)a, pat, 0.5 * xy_sat, args);
+                pt.at90 = measure(size, (noc_algo)a, pat, 0.9 * xy_sat, args);
+                pt.ok50 = !saturated(pt.at50, pt.zero_load);
+                pt.ok90 = !saturated(pt.at90, pt.zero_load);
+                std::cout << std::left << std::setw(16) << pattern_name(pat) << std::setw(12) << algo_name((noc_algo)a)
+                          << std::right << std::fixed << std::setprecision(1) << std::setw(10) << pt.zero_load
+                          << std::setprecision(3) << std::setw(10) << pt.sat_rate << std::setw(10) << pt.sat_accepted
+                          << std::setprecision(2) << std::setw(8) << (xy_sat > 0 ? pt.sat_rate / xy_sat : 0.0) << "x"
+                          << std::setw(9) << latency_cell(pt.ok50, pt.at50.p99)
+                          << std::setw(10) << latency_cell(pt.ok50, pt.at50.p999)
+                          << std::setw(9) << latency_cell(pt.ok90, pt.at90.p99)
+                          << std::setw(10) << latency_cell(pt.ok90, pt.at90.p999) << std::endl;
+            }
+            bool sane = true;
+            for (const study_point& pt : pts) sane = sane && pt.sat_rate > 0 && pt.zero_load > 0;
+            std::ostringstream what;
+            what << size << "x" << size << " " << pattern_name(pat) << ": every algorithm carries load";
+            check(sane && pts[ALGO_XY].ok50, what.str());
+        }
+        std::cout << "  (" << std::fixed << std::setprecision(1)
+                  << std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count() << " s)" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<int> sizes = { 8 };
+    std::vector<noc_pattern> patterns = { PAT_GEMM, PAT_ALLREDUCE, PAT_ALLREDUCE_RAND };
+    study_args args;
+    for (int i = 1; i < argc; i++) {
+        const std::string a = argv[i];
+        const size_t eq = a.find('=');
+        const std::string key = a.substr(0, eq);
+        const std::string val = eq == std::string::npos ? "" : a.substr(eq + 1);
+        if (key == "sizes") {
+            sizes.clear();
+            for (const std::string& s : split(val)) sizes.push_back(std::atoi(s.c_str()));
+        } else if (key == "patterns") {
+            patterns.clear();
+            for (const std::string& s : split(val)) {
+                noc_pattern p;
+                if (!parse_pattern(s, p)) {
+                    std::cerr << "tb_noc_routing: unknown pattern " << s << std::endl;
+                    return 2;
+                }
+                patterns.push_back(p);
+            }
+        } else if (key == "cycles") {
+            args.cycles = std::atoi(val.c_str());
+        } else {
+            std::cerr << "tb_noc_routing: unknown argument " << a << std::endl;
+            return 2;
+        }
+    }
+    for (int s : sizes) {
+        noc_config cfg;
+        cfg.cols = cfg.rows = s;
+        std::string err;
+        if (!cfg.valid(&err) || args.cycles < 100) {
+            std::cerr << "tb_noc_routing: bad size or cycles" << std::endl;
+            return 2;
+        }
+    }
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "NoC Routing Engine" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    test_route_table();
+    test_routing_functions();
+    test_drain();
+    run_study(sizes, patterns, args);
+
+    std::cout << "\n========================================" << std::endl;
+    if (failed == 0) {
+        std::cout << "SUCCESS: All NoC routing checks passed!" << std::endl;
+    } else {
+        std::cout << "FAILURE: " << failed << " NoC routing checks failed!" << std::endl;
+    }
+    std::cout << "========================================" << std::endl;
+
+    return failed ? 1 : 0;
+}
@@ -1,11 +1,22 @@
 // Activation Unit SystemC Model
-// Supports ReLU, GELU, Sigmoid, Tanh activation functions
+// Supports ReLU, GELU, Sigmoid, Tanh activation functions and online softmax
+//
+// Softmax (activation_type 5) is stateful and spans many beats. act_op
+// (instruction[25:24]) selects the step, mirroring the MAC sub-ops:
+//   LOAD  (0) start a row: reset the running max/sum, then fold this beat
+//   CLEAR (1) reset the running max/sum
+//   ACC   (2) fold this beat into the running max/sum
+//   DRAIN (3) normalization pass: emit exp(x - max) / sum for this beat
+// Each lane keeps its own running state; the lanes are merged on the first
+// DRAIN beat of a row. Softmax lanes are Q(DATA_WIDTH/2).(DATA_WIDTH/2)
+// fixed point on both input and output.
 
 #ifndef ACTIVATION_UNIT_SC_H
 #define ACTIVATION_UNIT_SC_H
 
 #include <systemc.h>
 #include <cmath>
+#include "softmax_kernel.h"
 
 template <int DATA_WIDTH, int VECTOR_WIDTH>
 class activation_unit_sc : public sc_module {
@@ -14,75 +25,125 @@ public:
     sc_in<bool> rst_n;
     sc_in<bool> enable;
     sc_in<sc_uint<8>> activation_type;
-    
+    sc_in<sc_uint<2>> act_op;
+
     // Input/Output (packed)
     sc_in<sc_bv<DATA_WIDTH * VECTOR_WIDTH>> data_i;
     sc_out<sc_bv<DATA_WIDTH * VECTOR_WIDTH>> data_o;
-    
+
     // Activation type constants
-    static const sc_uint8> ACT_RELU = 1;
-    static const sc_uint8> ACT_GELU = 2;
-    static const sc_uint8> ACT_SIGMOID = 3;
-    static const sc_uint8> ACT_TANH = 4;
-    
+    static const int ACT_RELU = 1;
+    static const int ACT_GELU = 2;
+    static const int ACT_SIGMOID = 3;
+    static const int ACT_TANH = 4;
+    static const int ACT_SOFTMAX = 5;
+
+    // Softmax steps (act_op)
+    static const int SMAX_LOAD = 0;
+    static const int SMAX_CLEAR = 1;
+    static const int SMAX_ACC = 2;
+    static const int SMAX_DRAIN = 3;
+    static const int SMAX_FRAC_BITS = DATA_WIDTH / 2;
+
     SC_CTOR(activation_unit_sc) {
         SC_METHOD(activation_process);
         sensitive << clk.pos();
         dont_initialize();
+        softmax_reset();
     }
-    
+
 private:
+    // Online softmax state, one running max/sum per lane
+    double smax_m[VECTOR_WIDTH];
+    double smax_s[VECTOR_WIDTH];
+    bool smax_merged;
+    double smax_row_max, smax_row_sum;
+
+    void softmax_reset() {
+        for (int i = 0; i < VECTOR_WIDTH; i++) softmax_kernel::lane_reset(smax_m[i], smax_s[i]);
+        smax_merged = false;
+    }
+
     void activation_process() {
         if (!rst_n.read()) {
             data_o.write(0);
+            softmax_reset();
             return;
         }
-        
+
         if (enable.read()) {
             sc_bv<DATA_WIDTH * VECTOR_WIDTH> input_packed = data_i.read();
             sc_bv<DATA_WIDTH * VECTOR_WIDTH> output_packed;
-            
+            const int type = (int)activation_type.read();
+
+            int val[VECTOR_WIDTH];
+            for (int i = 0; i < VECTOR_WIDTH; i++) {
+                val[i] = (int)input_packed.range(i * DATA_WIDTH + DATA_WIDTH - 1, i * DATA_WIDTH).to_int();
+            }
+
+            if (type == ACT_SOFTMAX) {
+                softmax_step(val);
+            }
+
             for (int i = 0; i < VECTOR_WIDTH; i++) {
-                // Extract element
-                int val = 0;
-                for (int bit = 0; bit < DATA_WIDTH; bit++) {
-                    if (input_packed.read()[i * DATA_WIDTH + bit])
-                        val |= (1 << bit);
-                }
-                
                 // Apply activation
                 int result = 0;
-                sc_uint<8> type = activation_type.read();
-                
+
                 switch (type) {
                     case ACT_RELU:
-                        result = (val > 0) ? val : 0;
+                        result = (val[i] > 0) ? val[i] : 0;
                         break;
                     case ACT_GELU:
                         // Approximate GELU: 0.5 * x * (1 + tanh(sqrt(2/pi) * (x + 0.044715 * x^3)))
-                        result = (int)(0.5 * val * (1.0 + tanh(0.797885 * (val + 0.044715 * val * val * val))));
+                        result = (int)(0.5 * val[i] * (1.0 + tanh(0.797885 * (val[i] + 0.044715 * val[i] * val[i] * val[i]))));
                         break;
                     case ACT_SIGMOID:
-                        result = (int)(1.0 / (1.0 + exp(-val)));
+                        result = (int)(1.0 / (1.0 + exp(-val[i])));
                         break;
                     case ACT_TANH:
-                        result = (int)tanh(val);
+                        result = (int)tanh(val[i]);
                         break;
                     default:
-                        result = val; // Passthrough
+                        result = val[i]; // Passthrough (softmax writes val in place)
                 }
-                
+
                 // Pack result
-                for (int bit = 0; bit < DATA_WIDTH; bit++) {
-                    output_packed.write()[i * DATA_WIDTH + bit] = (result >> bit) & 1;
-                }
+                output_packed.range(i * DATA_WIDTH + DATA_WIDTH - 1, i * DATA_WIDTH) = result;
             }
-            
+
             data_o.write(output_packed);
         } else {
             data_o.write(data_i.read());
         }
     }
+
+    // Stats beats pass the input through; DRAIN beats are replaced by probabilities
+    void softmax_step(int* val) {
+        const double scale = (double)(1LL << SMAX_FRAC_BITS);
+        switch ((int)act_op.read()) {
+            case SMAX_CLEAR:
+                softmax_reset();
+                break;
+            case SMAX_LOAD:
+                softmax_reset();
+                // fall through
+            case SMAX_ACC:
+                for (int i = 0; i < VECTOR_WIDTH; i++)
+                    softmax_kernel::lane_fold(smax_m[i], smax_s[i], val[i] / scale);
+                smax_merged = false;
+                break;
+            case SMAX_DRAIN:
+                if (!smax_merged) {
+                    softmax_kernel::lane_merge(smax_m, smax_s, VECTOR_WIDTH, 1, smax_row_max, smax_row_sum);
+                    smax_merged = true;
+                }
+                for (int i = 0; i < VECTOR_WIDTH; i++) {
+                    double p = softmax_kernel::lane_prob(val[i] / scale, smax_row_max, smax_row_sum);
+                    val[i] = (int)std::lround(p * scale);
+                }
+                break;
+        }
+    }
 };
 
 #endif // ACTIVATION_UNIT_SC_H
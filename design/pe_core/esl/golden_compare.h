@@ -0,0 +1,244 @@
+// Golden Result Comparator (ESL)
+// Vectorized output-vs-golden checking with per-tensor error statistics
+//
+// An element passes when |got - expected| <= atol + rtol * |expected|, or
+// when it is within max_ulp units in the last place (so max_ulp = 0 still
+// accepts bit-identical values). NaN only matches NaN. Per tensor the
+// comparator reports max abs / rel / ULP error, the mismatch count and the
+// first failing element. Elements stream through LANES independent
+// accumulators per block, so the loops vectorize without -ffast-math; the
+// first failure is located by rescanning only the block that holds it.
+// Integer tensors use the same path, with ULP = absolute difference.
+// No SystemC dependency.
+
+#ifndef GOLDEN_COMPARE_H
+#define GOLDEN_COMPARE_H
+
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <sstream>
+#include <iomanip>
+#include "tensor_io.h"
+
+namespace golden {
+
+struct tolerance {
+    double atol = 0.0;
+    double rtol = 0.0;
+    uint32_t max_ulp = 0;
+};
+
+struct result {
+    std::string name;
+    std::vector<size_t> shape;      // For first-failure coordinates; may be empty
+    size_t count = 0;
+    size_t mismatches = 0;
+    double max_abs = 0.0;
+    double max_rel = 0.0;
+    uint64_t max_ulp = 0;
+    bool has_failure = false;
+    size_t first_index = 0;
+    double first_got = 0.0;
+    double first_expected = 0.0;
+    double seconds = 0.0;           // Time spent comparing
+
+    bool passed() const { return mismatches == 0; }
+    std::string first_location() const {
+        if (!has_failure) return "-";
+        return shape.empty() ? "[" + std::to_string(first_index) + "]"
+                             : tensor_io::coord_string(shape, first_index);
+    }
+};
+
+// Ordered integer key: ULP distance = |key(a) - key(b)|
+template <typename T> struct elem_traits;
+
+template <> struct elem_traits<float> {
+    static int64_t key(float v) {
+        int32_t i;
+        std::memcpy(&i, &v, sizeof(i));
+        return i < 0 ? (int64_t)INT32_MIN - i : (int64_t)i;
+    }
+    static bool is_nan(float v) { return v != v; }
+};
+
+template <> struct elem_traits<int32_t> {
+    static int64_t key(int32_t v) { return v; }
+    static bool is_nan(int32_t) { return false; }
+};
+
+const int LANES = 16;
+const size_t BLOCK = 4096;
+
+template <typename T>
+inline bool element_ok(T g, T e, const tolerance& tol) {
+    typedef elem_traits<T> tr;
+    const double d = std::fabs((double)g - (double)e);
+    const int64_t kd = tr::key(g) - tr::key(e);
+    const uint64_t ulp = (uint64_t)(kd < 0 ? -kd : kd);
+    const bool nan_g = tr::is_nan(g), nan_e = tr::is_nan(e);
+    return (nan_g & nan_e) |
+           ((!(nan_g | nan_e)) & ((d <= tol.atol + tol.rtol * std::fabs((double)e)) | (ulp <= tol.max_ulp)));
+}
+
+// Fold elements [offset, offset + n) of a tensor into r. Call once for a
+// whole tensor, or repeatedly as output blocks arrive.
+template <typename T>
+inline void accumulate(result& r, const T* got, const T* expected, size_t n, size_t offset,
+                       const tolerance& tol) {
+    typedef elem_traits<T> tr;
+    auto t0 = std::chrono::steady_clock::now();
+
+    alignas(64) double abs_l[LANES], rel_l[LANES];
+    alignas(64) uint64_t ulp_l[LANES];
+    alignas(64) uint32_t bad_l[LANES];
+    for (int l = 0; l < LANES; l++) {
+        abs_l[l] = rel_l[l] = 0.0;
+        ulp_l[l] = 0;
+    }
+
+    for (size_t base = 0; base < n; base += BLOCK) {
+        const size_t len = n - base < BLOCK ? n - base : BLOCK;
+        const T* g = got + base;
+        const T* e = expected + base;
+        for (int l = 0; l < LANES; l++) bad_l[l] = 0;
+
+        size_t i = 0;
+        for (; i + LANES <= len; i += LANES) {
+            for (int l = 0; l < LANES; l++) {
+                const T gv = g[i + l], ev = e[i + l];
+                const double d = std::fabs((double)gv - (double)ev);
+                const double ae = std::fabs((double)ev);
+                const double rel = ae > 0.0 ? d / ae : 0.0;
+                const int64_t kd = tr::key(gv) - tr::key(ev);
+                const uint64_t ulp = (uint64_t)(kd < 0 ? -kd : kd);
+                const bool nan_g = tr::is_nan(gv), nan_e = tr::is_nan(ev);
+                const bool ok = (nan_g & nan_e) |
+                                ((!(nan_g | nan_e)) & ((d <= tol.atol + tol.rtol * ae) | (ulp <= tol.max_ulp)));
+                // NaN lanes fail the comparisons and leave the maxima alone
+                abs_l[l] = d > abs_l[l] ? d : abs_l[l];
+                rel_l[l] = rel > rel_l[l] ? rel : rel_l[l];
+                ulp_l[l] = ((!(nan_g | nan_e)) & (ulp > ulp_l[l])) ? ulp : ulp_l[l];
+                bad_l[l] += !ok;
+            }
+        }
+        uint32_t bad = 0;
+        for (int l = 0; l < LANES; l++) bad += bad_l[l];
+        // Tail, scalar
+        for (; i < len; i++) {
+            const double d = std::fabs((double)g[i] - (double)e[i]);
+            const double ae = std::fabs((double)e[i]);
+            const int64_t kd = tr::key(g[i]) - tr::key(e[i]);
+            const uint64_t ulp = (uint64_t)(kd < 0 ? -kd : kd);
+            abs_l[0] = d > abs_l[0] ? d : abs_l[0];
+            if (ae > 0.0) rel_l[0] = d / ae > rel_l[0] ? d / ae : rel_l[0];
+            if (!tr::is_nan(g[i]) && !tr::is_nan(e[i]) && ulp > ulp_l[0]) ulp_l[0] = ulp;
+            bad += !element_ok(g[i], e[i], tol);
+        }
+
+        if (bad && !r.has_failure) {
+            for (size_t j = 0; j < len; j++) {
+                if (!element_ok(g[j], e[j], tol)) {
+                    r.has_failure = true;
+                    r.first_index = offset + base + j;
+                    r.first_got = (double)g[j];
+                    r.first_expected = (double)e[j];
+                    break;
+                }
+            }
+        }
+        r.mismatches += bad;
+    }
+
+    for (int l = 0; l < LANES; l++) {
+        r.max_abs = abs_l[l] > r.max_abs ? abs_l[l] : r.max_abs;
+        r.max_rel = rel_l[l] > r.max_rel ? rel_l[l] : r.max_rel;
+        r.max_ulp = ulp_l[l] > r.max_ulp ? ulp_l[l] : r.max_ulp;
+    }
+    r.count += n;
+    r.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+template <typename T>
+inline result compare(const std::string& name, const T* got, const T* expected, size_t n,
+                      const tolerance& tol, const std::vector<size_t>& shape = std::vector<size_t>()) {
+    result r;
+    r.name = name;
+    r.shape = shape;
+    accumulate(r, got, expected, n, 0, tol);
+    return r;
+}
+
+// Against a mapped golden; a dtype mismatch counts every element as failing
+template <typename T>
+inline result compare(const std::string& name, const T* got, const tensor_io::mapped_tensor& golden,
+                      const tolerance& tol) {
+    const T* e = golden.data<T>();
+    if (!e) {
+        result r;
+        r.name = name + " (dtype mismatch)";
+        r.count = r.mismatches = golden.count();
+        return r;
+    }
+    return compare(name, got, e, golden.count(), tol, golden.shape());
+}
+
+// Collects per-tensor results and prints one table. Results added with
+// add_expected_failure() are negative tests: they report "caught (expected)"
+// when they fail and FAIL only when they unexpectedly pass.
+class checker {
+public:
+    void add(const result& r) { entries.push_back(entry{ r, true }); }
+    void add_expected_failure(const result& r) { entries.push_back(entry{ r, false }); }
+
+    // True if every result matched its expectation
+    bool all_passed() const {
+        for (const entry& e : entries)
+            if (e.res.passed() != e.should_pass) return false;
+        return true;
+    }
+
+    double seconds() const {
+        double s = 0.0;
+        for (const entry& e : entries) s += e.res.seconds;
+        return s;
+    }
+
+    void report(std::ostream& os) const {
+        os << std::left << std::setw(16) << "Tensor" << std::right << std::setw(10) << "Elems"
+           << std::setw(10) << "Mismatch" << std::setw(12) << "max abs" << std::setw(12) << "max rel"
+           << std::setw(12) << "max ULP" << "  " << std::left << std::setw(36) << "First failure"
+           << "  Check" << std::endl;
+        for (const entry& e : entries) {
+            const result& r = e.res;
+            const char* verdict = r.passed() == e.should_pass ? (r.passed() ? "ok" : "caught (expected)") : "FAIL";
+            std::string first = r.first_location();
+            if (r.has_failure) {
+                std::ostringstream v;
+                v << " got " << r.first_got << " exp " << r.first_expected;
+                first += v.str();
+            }
+            os << std::left << std::setw(16) << r.name << std::right << std::setw(10) << r.count
+               << std::setw(10) << r.mismatches << std::scientific << std::setprecision(2)
+               << std::setw(12) << r.max_abs << std::setw(12) << r.max_rel << std::defaultfloat
+               << std::setw(12) << r.max_ulp << "  " << std::left << std::setw(36) << first
+               << "  " << verdict << std::right << std::endl;
+        }
+    }
+
+private:
+    struct entry {
+        result res;
+        bool should_pass;
+    };
+    std::vector<entry> entries;
+};
+
+} // namespace golden
+
+#endif // GOLDEN_COMPARE_H
@@ -1,5 +1,14 @@
 // MAC Array SystemC Model
 // Electronic System Level (ESL) model for PE Core
+//
+// mac_op selects the accumulator update (instruction[25:24], see mac_array.v):
+//   MAC_OP_LOAD  - acc = dot product, result updated (legacy behaviour)
+//   MAC_OP_CLEAR - acc = 0
+//   MAC_OP_ACC   - acc += dot product, result held
+//   MAC_OP_DRAIN - result = saturate(acc), acc = 0
+
+#ifndef MAC_ARRAY_SC_H
+#define MAC_ARRAY_SC_H
 
 #include <systemc.h>
 #include <vector>
@@ -11,6 +20,7 @@ public:
     sc_in<bool> clk;
     sc_in<bool> rst_n;
     sc_in<bool> enable;
+    sc_in<sc_uint<2>> mac_op;
     
     // Packed data inputs
     sc_in<sc_bv<DATA_WIDTH * ARRAY_COLS>> data_a_i;
@@ -20,6 +30,12 @@ public:
     // Output
     sc_out<sc_bv<DATA_WIDTH * ARRAY_ROWS>> mac_result;
     
+    // Accumulator sub-operations
+    static const int MAC_OP_LOAD = 0;
+    static const int MAC_OP_CLEAR = 1;
+    static const int MAC_OP_ACC = 2;
+    static const int MAC_OP_DRAIN = 3;
+    
     // Constructor
     SC_CTOR(mac_array_sc) {
         SC_METHOD(mac_process);
@@ -29,16 +45,28 @@ public:
         // Initialize accumulators
         for (int i = 0; i < ARRAY_ROWS; i++) {
             accumulators[i] = 0;
+            results[i] = 0;
         }
     }
     
 private:
-    sc_int<DATA_WIDTH * 2 + 8> accumulators[ARRAY_ROWS];
+    // Full-width accumulators persist across ACC beats until drained
+    sc_bigint<DATA_WIDTH * 2 + 8> accumulators[ARRAY_ROWS];
+    int results[ARRAY_ROWS];
+    
+    static int saturate(const sc_bigint<DATA_WIDTH * 2 + 8>& v) {
+        const int64_t max_val = (int64_t(1) << (DATA_WIDTH - 1)) - 1;
+        const int64_t min_val = -(int64_t(1) << (DATA_WIDTH - 1));
+        if (v > max_val) return (int)max_val;
+        if (v < min_val) return (int)min_val;
+        return v.to_int();
+    }
     
     void mac_process() {
         if (!rst_n.read()) {
             for (int i = 0; i < ARRAY_ROWS; i++) {
                 accumulators[i] = 0;
+                results[i] = 0;
             }
             mac_result.write(0);
             return;
@@ -49,7 +77,7 @@ private:
             sc_bv<DATA_WIDTH * ARRAY_ROWS> b_packed = data_b_i.read();
             sc_bv<DATA_WIDTH * ARRAY_COLS> w_packed = weight_i.read();
             
-            sc_int<DATA_WIDTH * 2 + 8> acc[ARRAY_ROWS] = {0};
+            sc_bigint<DATA_WIDTH * 2 + 8> acc[ARRAY_ROWS];
             
             // Unpack and compute
             for (int row = 0; row < ARRAY_ROWS; row++) {
@@ -57,34 +85,49 @@ private:
                     // Extract b_vec[row]
                     int b_val = 0;
                     for (int bit = 0; bit < DATA_WIDTH; bit++) {
-                        if (b_packed.read()[row * DATA_WIDTH + bit])
+                        if (b_packed[row * DATA_WIDTH + bit])
                             b_val |= (1 << bit);
                     }
                     
                     // Extract w_vec[col]
                     int w_val = 0;
                     for (int bit = 0; bit < DATA_WIDTH; bit++) {
-                        if (w_packed.read()[col * DATA_WIDTH + bit])
+                        if (w_packed[col * DATA_WIDTH + bit])
                             w_val |= (1 << bit);
                     }
                     
                     // Multiply and accumulate
-                    acc[row] += b_val * w_val;
+                    acc[row] += (int64_t)b_val * w_val;
                 }
             }
             
-            // Store results
+            // Update accumulators according to the sub-operation
+            int op = mac_op.read().to_int();
             for (int i = 0; i < ARRAY_ROWS; i++) {
-                accumulators[i] = acc[i];
+                switch (op) {
+                    case MAC_OP_CLEAR:
+                        accumulators[i] = 0;
+                        break;
+                    case MAC_OP_ACC:
+                        accumulators[i] += acc[i];
+                        break;
+                    case MAC_OP_DRAIN:
+                        results[i] = saturate(accumulators[i]);
+                        accumulators[i] = 0;
+                        break;
+                    default: // MAC_OP_LOAD
+                        accumulators[i] = acc[i];
+                        results[i] = acc[i].to_int();
+                }
             }
         }
         
         // Pack output
         sc_bv<DATA_WIDTH * ARRAY_ROWS> result_packed;
         for (int row = 0; row < ARRAY_ROWS; row++) {
-            int val = (int)accumulators[row];
+            int val = results[row];
             for (int bit = 0; bit < DATA_WIDTH; bit++) {
-                result_packed.write()[row * DATA_WIDTH + bit] = (val >> bit) & 1;
+                result_packed[row * DATA_WIDTH + bit] = (val >> bit) & 1;
             }
         }
         mac_result.write(result_packed);
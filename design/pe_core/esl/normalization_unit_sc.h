@@ -20,8 +20,8 @@ public:
     sc_out<sc_bv<DATA_WIDTH * VECTOR_WIDTH>> data_o;
     
     // Normalization type constants
-    static const sc_uint8> NORM_LAYER = 0;
-    static const sc_uint8> NORM_RMS = 1;
+    static const int NORM_LAYER = 0;
+    static const int NORM_RMS = 1;
     
     SC_CTOR(normalization_unit_sc) {
         SC_METHOD(norm_process);
@@ -38,14 +38,14 @@ private:
         
         if (enable.read()) {
             sc_bv<DATA_WIDTH * VECTOR_WIDTH> input_packed = data_i.read();
-            sc_bv<DATA_WIDTH * VECTOR_WIDTH>> output_packed;
+            sc_bv<DATA_WIDTH * VECTOR_WIDTH> output_packed;
             
             // Extract elements
             double values[VECTOR_WIDTH];
             for (int i = 0; i < VECTOR_WIDTH; i++) {
                 int val = 0;
                 for (int bit = 0; bit < DATA_WIDTH; bit++) {
-                    if (input_packed.read()[i * DATA_WIDTH + bit])
+                    if (input_packed[i * DATA_WIDTH + bit])
                         val |= (1 << bit);
                 }
                 values[i] = (double)val;
@@ -84,7 +84,7 @@ private:
                 // Pack result
                 int int_result = (int)result;
                 for (int bit = 0; bit < DATA_WIDTH; bit++) {
-                    output_packed.write()[i * DATA_WIDTH + bit] = (int_result >> bit) & 1;
+                    output_packed[i * DATA_WIDTH + bit] = (int_result >> bit) & 1;
                 }
             }
             
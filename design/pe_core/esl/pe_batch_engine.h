@@ -0,0 +1,289 @@
+// Batched PE Engine (ESL)
+// Structure-of-arrays datapath that steps NUM_PES identical PEs per call.
+//
+// Every piece of per-PE state is stored lane-major ([row * NUM_PES + pe]) so
+// the innermost loops run across PEs and vectorize. Cycle behaviour matches
+// pe_top_sc: MAC -> activation -> normalization registers, each sampling the
+// previous stage's value at the clock edge. No SystemC dependency; see
+// pe_batch_sc.h for the module wrapper.
+
+#ifndef PE_BATCH_ENGINE_H
+#define PE_BATCH_ENGINE_H
+
+#include <cstdint>
+#include <cmath>
+#include <cstring>
+#include "softmax_kernel.h"
+
+template <int DATA_WIDTH, int MAC_ROWS, int MAC_COLS, int NUM_PES>
+class pe_batch_engine {
+    static_assert(DATA_WIDTH > 0 && DATA_WIDTH <= 32, "lanes are 32-bit");
+
+public:
+    // Accumulator width of mac_array_sc; kept as a lo/hi pair per lane
+    static const int ACC_BITS = DATA_WIDTH * 2 + 8;
+
+    // Instruction fields (see pe_top_sc::decode_instruction)
+    static const int OP_MAC = 1;
+    static const int OP_ACT = 2;
+    static const int OP_NORM = 3;
+    static const int MAC_OP_LOAD = 0;
+    static const int MAC_OP_CLEAR = 1;
+    static const int MAC_OP_ACC = 2;
+    static const int MAC_OP_DRAIN = 3;
+    static const int ACT_RELU = 1;
+    static const int ACT_GELU = 2;
+    static const int ACT_SIGMOID = 3;
+    static const int ACT_TANH = 4;
+    static const int ACT_SOFTMAX = 5;
+    static const int SMAX_FRAC_BITS = DATA_WIDTH / 2;
+    static const int NORM_RMS = 1;
+
+    pe_batch_engine() { reset(); }
+
+    void reset() {
+        std::memset(acc_lo, 0, sizeof(acc_lo));
+        std::memset(acc_hi, 0, sizeof(acc_hi));
+        std::memset(mac_res, 0, sizeof(mac_res));
+        std::memset(act_res, 0, sizeof(act_res));
+        std::memset(norm_res, 0, sizeof(norm_res));
+        for (int l = 0; l < LANES; l++) softmax_kernel::lane_reset(smax_m[l], smax_s[l]);
+        std::memset(smax_merged, 0, sizeof(smax_merged));
+    }
+
+    // Advance all PEs by one clock edge.
+    //   instr[pe], valid[pe]      - per-PE control
+    //   b[row * NUM_PES + pe]     - data_b lanes (MAC_ROWS)
+    //   w[col * NUM_PES + pe]     - weight lanes (MAC_COLS)
+    void step(const uint32_t* instr, const uint8_t* valid,
+              const int32_t* b, const int32_t* w) {
+        decode(instr, valid);
+        // Later stages sample the registers before the MAC stage updates them
+        norm_stage();
+        act_stage();
+        mac_stage(b, w);
+    }
+
+    // Register lanes, [row * NUM_PES + pe]
+    int32_t mac_result(int pe, int row) const { return mac_res[row * NUM_PES + pe]; }
+    int32_t act_result(int pe, int row) const { return act_res[row * NUM_PES + pe]; }
+    int32_t norm_result(int pe, int row) const { return norm_res[row * NUM_PES + pe]; }
+
+    // Register row selected by pe_top_sc::output_mux for this instruction
+    // (lanes indexed by PE); nullptr when data_a is passed through instead.
+    const int32_t* select_output(uint32_t instr, int row) const {
+        switch (instr >> 28) {
+            case OP_NORM: return &norm_res[row * NUM_PES];
+            case OP_ACT:  return &act_res[row * NUM_PES];
+            case OP_MAC:  return &mac_res[row * NUM_PES];
+            default:      return nullptr;
+        }
+    }
+
+    // Truncate to DATA_WIDTH bits the way the packed sc_bv ports do
+    static int32_t to_lane(int64_t v) {
+        if (DATA_WIDTH == 32) return (int32_t)(uint32_t)v;
+        return (int32_t)((uint64_t)v & ((uint64_t(1) << DATA_WIDTH) - 1));
+    }
+
+private:
+    static const int LANES = MAC_ROWS * NUM_PES;
+
+    // Decoded per-PE control
+    alignas(64) uint8_t mac_en[NUM_PES];
+    alignas(64) uint8_t mac_op[NUM_PES];
+    alignas(64) uint8_t act_en[NUM_PES];
+    alignas(64) uint8_t act_type[NUM_PES];
+    alignas(64) uint8_t act_op[NUM_PES];
+    alignas(64) uint8_t norm_en[NUM_PES];
+    alignas(64) uint8_t norm_type[NUM_PES];
+
+    // Per-PE state
+    alignas(64) uint64_t acc_lo[LANES];
+    alignas(64) int64_t acc_hi[LANES];
+    alignas(64) int32_t mac_res[LANES];
+    alignas(64) int32_t act_res[LANES];
+    alignas(64) int32_t norm_res[LANES];
+
+    // Online softmax running state (activation_unit_sc), per lane and per PE
+    alignas(64) double smax_m[LANES];
+    alignas(64) double smax_s[LANES];
+    alignas(64) double smax_row_max[NUM_PES];
+    alignas(64) double smax_row_sum[NUM_PES];
+    alignas(64) uint8_t smax_merged[NUM_PES];
+
+    void decode(const uint32_t* instr, const uint8_t* valid) {
+        for (int pe = 0; pe < NUM_PES; pe++) {
+            uint32_t opcode = instr[pe] >> 28;
+            mac_en[pe] = (opcode == OP_MAC) & (valid[pe] != 0);
+            mac_op[pe] = (instr[pe] >> 24) & 0x3;
+            act_en[pe] = (opcode == OP_ACT) & (valid[pe] != 0);
+            act_type[pe] = instr[pe] & 0xFF;
+            act_op[pe] = (instr[pe] >> 24) & 0x3;
+            norm_en[pe] = opcode == OP_NORM;
+            norm_type[pe] = instr[pe] & 0xFF;
+        }
+    }
+
+    // Wrap a 128-bit lo/hi pair to ACC_BITS, sign-extended
+    static void wrap_acc(uint64_t& lo, int64_t& hi) {
+        if (ACC_BITS >= 128) return;
+        if (ACC_BITS > 64) {
+            const int sh = 128 - ACC_BITS;
+            hi = (int64_t)((uint64_t)hi << sh) >> sh;
+        } else {
+            const int sh = 64 - ACC_BITS;
+            int64_t s = (int64_t)(lo << sh) >> sh;
+            lo = (uint64_t)s;
+            hi = s >> 63;
+        }
+    }
+
+    // Saturate a 128-bit lo/hi pair to the signed DATA_WIDTH range
+    static int64_t saturate(uint64_t lo, int64_t hi) {
+        const int64_t max_val = (int64_t(1) << (DATA_WIDTH - 1)) - 1;
+        const int64_t min_val = -(int64_t(1) << (DATA_WIDTH - 1));
+        int64_t lo_s = (int64_t)lo;
+        bool fits64 = hi == (lo_s >> 63);
+        int64_t clamped = lo_s > max_val ? max_val : (lo_s < min_val ? min_val : lo_s);
+        return fits64 ? clamped : (hi < 0 ? min_val : max_val);
+    }
+
+    void mac_stage(const int32_t* b, const int32_t* w) {
+        for (int row = 0; row < MAC_ROWS; row++) {
+            const int32_t* b_row = &b[row * NUM_PES];
+            for (int pe = 0; pe < NUM_PES; pe++) {
+                const int l = row * NUM_PES + pe;
+
+                // Dot product of this row, as a 128-bit lo/hi pair
+                uint64_t dot_lo = 0;
+                int64_t dot_hi = 0;
+                for (int col = 0; col < MAC_COLS; col++) {
+                    int64_t p = (int64_t)b_row[pe] * w[col * NUM_PES + pe];
+                    uint64_t lo = dot_lo + (uint64_t)p;
+                    dot_hi += (p >> 63) + (lo < dot_lo);
+                    dot_lo = lo;
+                }
+
+                // acc + dot for MAC_OP_ACC
+                uint64_t sum_lo = acc_lo[l] + dot_lo;
+                int64_t sum_hi = acc_hi[l] + dot_hi + (sum_lo < acc_lo[l]);
+                wrap_acc(sum_lo, sum_hi);
+
+                const int op = mac_op[pe];
+                const bool en = mac_en[pe];
+                const bool load = en & (op == MAC_OP_LOAD);
+                const bool accum = en & (op == MAC_OP_ACC);
+                const bool zero = en & ((op == MAC_OP_CLEAR) | (op == MAC_OP_DRAIN));
+                const bool drain = en & (op == MAC_OP_DRAIN);
+
+                int32_t drained = to_lane(saturate(acc_lo[l], acc_hi[l]));
+                int32_t loaded = to_lane((int32_t)(uint32_t)dot_lo);
+                mac_res[l] = load ? loaded : (drain ? drained : mac_res[l]);
+
+                acc_lo[l] = load ? dot_lo : (accum ? sum_lo : (zero ? 0 : acc_lo[l]));
+                acc_hi[l] = load ? dot_hi : (accum ? sum_hi : (zero ? 0 : acc_hi[l]));
+            }
+        }
+    }
+
+    void act_stage() {
+        softmax_stage();
+        for (int row = 0; row < MAC_ROWS; row++) {
+            for (int pe = 0; pe < NUM_PES; pe++) {
+                const int l = row * NUM_PES + pe;
+                const int32_t val = mac_res[l];
+                int32_t r;
+                switch (act_en[pe] ? act_type[pe] : 0) {
+                    case ACT_RELU:
+                        r = val > 0 ? val : 0;
+                        break;
+                    case ACT_GELU:
+                        r = (int32_t)(0.5 * val * (1.0 + std::tanh(0.797885 * (val + 0.044715 * val * val * val))));
+                        break;
+                    case ACT_SIGMOID:
+                        r = (int32_t)(1.0 / (1.0 + std::exp(-(double)val)));
+                        break;
+                    case ACT_TANH:
+                        r = (int32_t)std::tanh((double)val);
+                        break;
+                    case ACT_SOFTMAX:
+                        r = act_op[pe] == MAC_OP_DRAIN ? softmax_prob(pe, val) : val;
+                        break;
+                    default:
+                        r = val; // Passthrough
+                }
+                act_res[l] = to_lane(r);
+            }
+        }
+    }
+
+    // Softmax steps share the MAC sub-op encoding: LOAD starts a row, CLEAR
+    // resets, ACC folds, DRAIN normalizes (lanes merged on its first beat)
+    void softmax_stage() {
+        const double scale = (double)(int64_t(1) << SMAX_FRAC_BITS);
+        for (int pe = 0; pe < NUM_PES; pe++) {
+            if (!act_en[pe] || act_type[pe] != ACT_SOFTMAX) continue;
+            const int op = act_op[pe];
+            if (op == MAC_OP_LOAD || op == MAC_OP_CLEAR) {
+                for (int row = 0; row < MAC_ROWS; row++)
+                    softmax_kernel::lane_reset(smax_m[row * NUM_PES + pe], smax_s[row * NUM_PES + pe]);
+                smax_merged[pe] = 0;
+            }
+            if (op == MAC_OP_LOAD || op == MAC_OP_ACC) {
+                for (int row = 0; row < MAC_ROWS; row++) {
+                    const int l = row * NUM_PES + pe;
+                    softmax_kernel::lane_fold(smax_m[l], smax_s[l], mac_res[l] / scale);
+                }
+                smax_merged[pe] = 0;
+            }
+            if (op == MAC_OP_DRAIN && !smax_merged[pe]) {
+                softmax_kernel::lane_merge(&smax_m[pe], &smax_s[pe], MAC_ROWS, NUM_PES,
+                                           smax_row_max[pe], smax_row_sum[pe]);
+                smax_merged[pe] = 1;
+            }
+        }
+    }
+
+    int32_t softmax_prob(int pe, int32_t val) const {
+        const double scale = (double)(int64_t(1) << SMAX_FRAC_BITS);
+        const double p = softmax_kernel::lane_prob(val / scale, smax_row_max[pe], smax_row_sum[pe]);
+        return (int32_t)std::lround(p * scale);
+    }
+
+    void norm_stage() {
+        alignas(64) double mean[NUM_PES];
+        alignas(64) double std_dev[NUM_PES];
+
+        // Statistics across rows, vectorized across PEs
+        for (int pe = 0; pe < NUM_PES; pe++) mean[pe] = 0.0;
+        for (int row = 0; row < MAC_ROWS; row++)
+            for (int pe = 0; pe < NUM_PES; pe++)
+                mean[pe] += (double)act_res[row * NUM_PES + pe];
+        for (int pe = 0; pe < NUM_PES; pe++) {
+            mean[pe] /= MAC_ROWS;
+            std_dev[pe] = 0.0;
+        }
+        for (int row = 0; row < MAC_ROWS; row++) {
+            for (int pe = 0; pe < NUM_PES; pe++) {
+                double diff = (double)act_res[row * NUM_PES + pe] - mean[pe];
+                std_dev[pe] += diff * diff;
+            }
+        }
+        for (int pe = 0; pe < NUM_PES; pe++)
+            std_dev[pe] = std::sqrt(std_dev[pe] / MAC_ROWS + 1e-8);
+
+        for (int row = 0; row < MAC_ROWS; row++) {
+            for (int pe = 0; pe < NUM_PES; pe++) {
+                const int l = row * NUM_PES + pe;
+                const double v = (double)act_res[l];
+                // Matches normalization_unit_sc: RMS scales by the same deviation
+                const double centered = (norm_type[pe] == NORM_RMS) ? v : v - mean[pe];
+                const int32_t normed = to_lane((int32_t)(centered / std_dev[pe]));
+                norm_res[l] = norm_en[pe] ? normed : act_res[l];
+            }
+        }
+    }
+};
+
+#endif // PE_BATCH_ENGINE_H
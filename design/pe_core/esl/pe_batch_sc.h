@@ -0,0 +1,129 @@
+// Batched PE SystemC Model (ESL)
+// Drop-in replacement for NUM_PES instances of pe_top_sc
+//
+// Exposes the pe_top_sc instruction/operand interface once per PE through
+// sc_vector ports, but evaluates every PE in a single clocked process using
+// the structure-of-arrays pe_batch_engine. Mesh-scale runs then cost one
+// process dispatch per cycle instead of 4 * NUM_PES.
+
+#ifndef PE_BATCH_SC_H
+#define PE_BATCH_SC_H
+
+#include <systemc.h>
+#include "pe_batch_engine.h"
+
+template <int DATA_WIDTH, int VECTOR_WIDTH, int MAC_ROWS, int MAC_COLS, int NUM_PES>
+class pe_batch_sc : public sc_module {
+    static_assert(MAC_ROWS <= VECTOR_WIDTH && MAC_COLS <= VECTOR_WIDTH,
+                  "MAC lanes are carried on the VECTOR_WIDTH operand ports");
+
+public:
+    typedef pe_batch_engine<DATA_WIDTH, MAC_ROWS, MAC_COLS, NUM_PES> engine_t;
+
+    // Clock and reset (shared by all PEs)
+    sc_in<bool> clk;
+    sc_in<bool> rst_n;
+
+    // Control interface, one element per PE
+    sc_vector<sc_in<bool>> valid_in;
+    sc_vector<sc_out<bool>> ready_out;
+    sc_vector<sc_in<sc_uint<32>>> instruction;
+
+    // Data inputs (packed), one element per PE
+    sc_vector<sc_in<sc_bv<DATA_WIDTH * VECTOR_WIDTH>>> data_a_i;
+    sc_vector<sc_in<sc_bv<DATA_WIDTH * VECTOR_WIDTH>>> data_b_i;
+    sc_vector<sc_in<sc_bv<DATA_WIDTH * VECTOR_WIDTH>>> weight_i;
+
+    // Data outputs (packed), one element per PE
+    sc_vector<sc_out<sc_bv<DATA_WIDTH * VECTOR_WIDTH>>> result_o;
+    sc_vector<sc_out<bool>> valid_out;
+
+    SC_CTOR(pe_batch_sc)
+        : valid_in("valid_in", NUM_PES)
+        , ready_out("ready_out", NUM_PES)
+        , instruction("instruction", NUM_PES)
+        , data_a_i("data_a_i", NUM_PES)
+        , data_b_i("data_b_i", NUM_PES)
+        , weight_i("weight_i", NUM_PES)
+        , result_o("result_o", NUM_PES)
+        , valid_out("valid_out", NUM_PES) {
+        SC_METHOD(step_process);
+        sensitive << clk.pos();
+        dont_initialize();
+
+        SC_METHOD(output_mux);
+        sensitive << state_updated;
+        for (int pe = 0; pe < NUM_PES; pe++) {
+            sensitive << valid_in[pe] << instruction[pe] << data_a_i[pe];
+        }
+        dont_initialize();
+    }
+
+    const engine_t& engine() const { return state; }
+
+private:
+    engine_t state;
+    sc_event state_updated;
+
+    // Input staging in SoA layout, [lane * NUM_PES + pe]
+    uint32_t instr_buf[NUM_PES];
+    uint8_t valid_buf[NUM_PES];
+    int32_t b_buf[MAC_ROWS * NUM_PES];
+    int32_t w_buf[MAC_COLS * NUM_PES];
+
+    static int32_t unpack_lane(const sc_bv<DATA_WIDTH * VECTOR_WIDTH>& packed, int idx) {
+        return engine_t::to_lane((int64_t)packed.range(idx * DATA_WIDTH + DATA_WIDTH - 1,
+                                                       idx * DATA_WIDTH).to_uint());
+    }
+
+    void step_process() {
+        if (!rst_n.read()) {
+            state.reset();
+            state_updated.notify(SC_ZERO_TIME);
+            return;
+        }
+
+        for (int pe = 0; pe < NUM_PES; pe++) {
+            instr_buf[pe] = instruction[pe].read().to_uint();
+            valid_buf[pe] = valid_in[pe].read();
+            const sc_bv<DATA_WIDTH * VECTOR_WIDTH> b_packed = data_b_i[pe].read();
+            const sc_bv<DATA_WIDTH * VECTOR_WIDTH> w_packed = weight_i[pe].read();
+            for (int row = 0; row < MAC_ROWS; row++)
+                b_buf[row * NUM_PES + pe] = unpack_lane(b_packed, row);
+            for (int col = 0; col < MAC_COLS; col++)
+                w_buf[col * NUM_PES + pe] = unpack_lane(w_packed, col);
+        }
+
+        state.step(instr_buf, valid_buf, b_buf, w_buf);
+        state_updated.notify(SC_ZERO_TIME);
+    }
+
+    void output_mux() {
+        for (int pe = 0; pe < NUM_PES; pe++) {
+            ready_out[pe].write(rst_n.read());
+
+            if (!valid_in[pe].read()) {
+                valid_out[pe].write(false);
+                continue;
+            }
+
+            uint32_t instr = instruction[pe].read().to_uint();
+            if (state.select_output(instr, 0) == nullptr) {
+                // Passthrough
+                result_o[pe].write(data_a_i[pe].read());
+                valid_out[pe].write(true);
+                continue;
+            }
+
+            sc_bv<DATA_WIDTH * VECTOR_WIDTH> output_packed;
+            for (int row = 0; row < MAC_ROWS; row++) {
+                uint32_t lane = (uint32_t)state.select_output(instr, row)[pe];
+                output_packed.range(row * DATA_WIDTH + DATA_WIDTH - 1, row * DATA_WIDTH) = lane;
+            }
+            result_o[pe].write(output_packed);
+            valid_out[pe].write(true);
+        }
+    }
+};
+
+#endif // PE_BATCH_SC_H
@@ -0,0 +1,105 @@
+// PE Command Processor SystemC Model (ESL)
+// Instruction/operand queues with backpressure in front of pe_top_sc
+//
+// Host side: valid_in/ready_out/instruction for the instruction stream and
+// data_valid_in/data_ready_out with the three operand vectors. ready_out is
+// low while the instruction FIFO is full. PE side: the pe_* outputs connect
+// to the pe_top_sc (or pe_batch_sc) ports of the same name without the
+// prefix, and pe_ready to its ready_out. Both host streams are sampled on the
+// rising edge when valid and ready are high; the issued instruction is
+// driven after the same edge, so the PE executes it on the next one.
+
+#ifndef PE_CMD_PROC_SC_H
+#define PE_CMD_PROC_SC_H
+
+#include <systemc.h>
+#include "pe_cmd_queue.h"
+
+template <int DATA_WIDTH, int VECTOR_WIDTH>
+class pe_cmd_proc_sc : public sc_module {
+public:
+    typedef sc_bv<DATA_WIDTH * VECTOR_WIDTH> vec_t;
+
+    struct operand {
+        vec_t a, b, w;
+    };
+    typedef pe_cmd_queue<operand> queue_t;
+
+    // Clock and reset
+    sc_in<bool> clk;
+    sc_in<bool> rst_n;
+
+    // Host instruction stream
+    sc_in<bool> valid_in;
+    sc_out<bool> ready_out;
+    sc_in<sc_uint<32>> instruction;
+
+    // Host operand stream
+    sc_in<bool> data_valid_in;
+    sc_out<bool> data_ready_out;
+    sc_in<vec_t> data_a_i;
+    sc_in<vec_t> data_b_i;
+    sc_in<vec_t> weight_i;
+
+    // To the PE
+    sc_out<bool> pe_valid;
+    sc_in<bool> pe_ready;
+    sc_out<sc_uint<32>> pe_instruction;
+    sc_out<vec_t> pe_data_a;
+    sc_out<vec_t> pe_data_b;
+    sc_out<vec_t> pe_weight;
+
+    // HALT reached
+    sc_out<bool> done;
+
+    pe_cmd_proc_sc(sc_module_name name, const pe_cmd_config& cfg = pe_cmd_config())
+        : sc_module(name), queue(cfg) {
+        SC_HAS_PROCESS(pe_cmd_proc_sc);
+        SC_METHOD(issue_process);
+        sensitive << clk.pos();
+        dont_initialize();
+    }
+
+    const queue_t& stats() const { return queue; }
+
+private:
+    queue_t queue;
+
+    void issue_process() {
+        if (!rst_n.read()) {
+            queue.reset();
+            ready_out.write(false);
+            data_ready_out.write(false);
+            pe_valid.write(false);
+            done.write(false);
+            return;
+        }
+
+        // Accept against the ready values the host saw this cycle
+        if (valid_in.read() && ready_out.read()) queue.push_instr(instruction.read().to_uint());
+        if (data_valid_in.read() && data_ready_out.read()) {
+            operand op = { data_a_i.read(), data_b_i.read(), weight_i.read() };
+            queue.push_operand(op);
+        }
+
+        uint32_t instr;
+        operand op;
+        if (queue.step(pe_ready.read(), instr, op)) {
+            pe_instruction.write(instr);
+            if (pe_ucode::needs_operand(instr)) {
+                pe_data_a.write(op.a);
+                pe_data_b.write(op.b);
+                pe_weight.write(op.w);
+            }
+            pe_valid.write(true);
+        } else {
+            pe_valid.write(false);
+        }
+
+        ready_out.write(!queue.instr_full());
+        data_ready_out.write(!queue.operand_full());
+        done.write(queue.is_halted());
+    }
+};
+
+#endif // PE_CMD_PROC_SC_H
@@ -0,0 +1,352 @@
+// PE Command Queue (ESL)
+// Instruction FIFO, hardware loops and issue statistics for pe_cmd_proc_sc
+//
+// Sits between the host and pe_top_sc. The host pushes instruction words into
+// a bounded FIFO (full = backpressure on ready_out) and operand beats into a
+// second FIFO. Each cycle step() issues at most one datapath instruction to
+// the PE, or records why it could not. pe_top_sc drops ready_out only in
+// reset, so a not-ready PE is not an issue slot and is not counted. Control
+// opcodes are consumed here and never reach the PE:
+//
+//   [31:28] = 0xC  LOOP    body = [23:16] instructions, run [15:0] times
+//   [31:28] = 0xD  REPEAT  issue the next datapath instruction [15:0] times
+//   [31:28] = 0xF  HALT    end of program
+//
+// A LOOP body is captured into the loop buffer during its first pass, so
+// later passes issue from the buffer without host traffic. Loops nest inside
+// a captured body up to loop_depth levels. MAC LOAD/ACC (0x1, sub-op [25:24]
+// = 0 or 2) consume one operand beat, and so does every other non-control
+// opcode (0x0, 0x4-0xB, 0xE): pe_top_sc passes data_a through for those. MAC
+// CLEAR and DRAIN only touch the accumulator, and activation (0x2) and
+// normalization (0x3) work on the MAC result, so they consume none.
+// No SystemC dependency.
+
+#ifndef PE_CMD_QUEUE_H
+#define PE_CMD_QUEUE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include <string>
+#include <ostream>
+#include <iomanip>
+
+// Control opcodes
+namespace pe_ucode {
+    const uint32_t OP_LOOP = 0xC;
+    const uint32_t OP_REPEAT = 0xD;
+    const uint32_t OP_HALT = 0xF;
+
+    inline uint32_t opcode(uint32_t w) { return w >> 28; }
+    inline uint32_t loop(uint32_t body, uint32_t count) {
+        return (OP_LOOP << 28) | ((body & 0xFF) << 16) | (count & 0xFFFF);
+    }
+    inline uint32_t repeat(uint32_t count) { return (OP_REPEAT << 28) | (count & 0xFFFF); }
+    inline uint32_t halt() { return OP_HALT << 28; }
+    inline bool needs_operand(uint32_t w) {
+        switch (opcode(w)) {
+            case 1: {
+                const uint32_t sub = (w >> 24) & 0x3;
+                return sub == 0 || sub == 2;
+            }
+            case 2: case 3: case OP_LOOP: case OP_REPEAT: case OP_HALT:
+                return false;
+            default:
+                return true;        // Passthrough of data_a
+        }
+    }
+
+    // Binary microprogram: little-endian header + instruction words
+    //   u32 magic "PEMP", u16 version, u16 flags, u32 num_words, u32 reserved
+    const uint32_t MAGIC = 0x504D4550;
+    const uint16_t VERSION = 1;
+
+    inline bool save(const std::string& path, const std::vector<uint32_t>& words) {
+        FILE* f = std::fopen(path.c_str(), "wb");
+        if (!f) return false;
+        const uint32_t hdr[4] = { MAGIC, VERSION, (uint32_t)words.size(), 0 };
+        bool ok = std::fwrite(hdr, sizeof(hdr), 1, f) == 1 &&
+                  std::fwrite(words.data(), sizeof(uint32_t), words.size(), f) == words.size();
+        std::fclose(f);
+        return ok;
+    }
+
+    // Returns false and sets err on a missing file, bad header, a word count
+    // the file cannot hold, or a short read
+    inline bool load(const std::string& path, std::vector<uint32_t>& words, std::string* err = nullptr) {
+        FILE* f = std::fopen(path.c_str(), "rb");
+        if (!f) {
+            if (err) *err = "cannot open " + path;
+            return false;
+        }
+        uint32_t hdr[4];
+        bool ok = std::fread(hdr, sizeof(hdr), 1, f) == 1;
+        if (!ok || hdr[0] != MAGIC || (hdr[1] & 0xFFFF) != VERSION) {
+            if (err) *err = path + ": not a version 1 PE microprogram";
+            std::fclose(f);
+            return false;
+        }
+        // Check the claimed size before allocating for it
+        long end = -1;
+        if (std::fseek(f, 0, SEEK_END) == 0) end = std::ftell(f);
+        const uint64_t held = end > (long)sizeof(hdr) ? (uint64_t)(end - sizeof(hdr)) / sizeof(uint32_t) : 0;
+        if (end < 0 || hdr[2] > held || std::fseek(f, (long)sizeof(hdr), SEEK_SET) != 0) {
+            if (err) {
+                *err = path + ": header claims " + std::to_string(hdr[2]) + " words, file holds " +
+                       std::to_string(held);
+            }
+            std::fclose(f);
+            return false;
+        }
+        words.resize(hdr[2]);
+        ok = std::fread(words.data(), sizeof(uint32_t), words.size(), f) == words.size();
+        std::fclose(f);
+        if (!ok && err) *err = path + ": truncated";
+        return ok;
+    }
+}
+
+struct pe_cmd_config {
+    int instr_depth = 8;            // Instruction FIFO entries
+    int operand_depth = 8;          // Operand FIFO entries
+    int loop_buffer = 256;          // Captured loop body words
+    int loop_depth = 4;             // Nested loop levels
+};
+
+template <typename OPERAND>
+class pe_cmd_queue {
+public:
+    // Why an issue slot went unused
+    enum stall_reason {
+        STALL_EMPTY = 0,            // No instruction from the host
+        STALL_OPERAND = 1,          // Instruction waits for an operand beat
+        STALL_CONTROL = 2,          // LOOP/REPEAT decode or loop body capture
+        NUM_STALLS = 3
+    };
+
+    explicit pe_cmd_queue(const pe_cmd_config& cfg = pe_cmd_config())
+        : cfg(cfg)
+        , instr_fifo(cfg.instr_depth)
+        , opnd_fifo(cfg.operand_depth)
+        , loop_buf(cfg.loop_buffer)
+        , loops(cfg.loop_depth) {
+        reset();
+    }
+
+    void reset() {
+        instr_head = instr_count = 0;
+        opnd_head = opnd_count = 0;
+        capture_len = capture_pos = 0;
+        loop_sp = 0;
+        pc = -1;
+        repeat_left = 0;
+        halted = false;
+        error.clear();
+        cycles = issued = host_words = active_cycles = full_cycles = 0;
+        for (int i = 0; i < NUM_STALLS; i++) stalls[i] = 0;
+    }
+
+    // ========================================
+    // Host side
+    // ========================================
+    bool instr_full() const { return instr_count == cfg.instr_depth; }
+    bool operand_full() const { return opnd_count == cfg.operand_depth; }
+
+    bool push_instr(uint32_t word) {
+        if (instr_full()) return false;
+        instr_fifo[(instr_head + instr_count++) % cfg.instr_depth] = word;
+        host_words++;
+        return true;
+    }
+
+    bool push_operand(const OPERAND& op) {
+        if (operand_full()) return false;
+        opnd_fifo[(opnd_head + opnd_count++) % cfg.operand_depth] = op;
+        return true;
+    }
+
+    // ========================================
+    // One clock edge
+    // ========================================
+    // Returns true and fills instr/op when a datapath instruction issues.
+    bool step(bool pe_ready, uint32_t& instr, OPERAND& op) {
+        cycles++;
+        if (halted || !pe_ready) return false;
+        active_cycles++;
+        if (instr_full()) full_cycles++;
+
+        // Loop body capture takes one host word per cycle
+        if (capture_pos < capture_len) {
+            if (!instr_count) return stall(STALL_EMPTY);
+            loop_buf[capture_pos++] = pop_instr();
+            if (capture_pos == capture_len) pc = 0;
+            return stall(STALL_CONTROL);
+        }
+
+        uint32_t w;
+        if (!peek(w)) return stall(STALL_EMPTY);
+
+        switch (pe_ucode::opcode(w)) {
+            case pe_ucode::OP_LOOP:
+                enter_loop(w);
+                return stall(STALL_CONTROL);
+            case pe_ucode::OP_REPEAT:
+                advance();
+                repeat_left = (int)(w & 0xFFFF);
+                return stall(STALL_CONTROL);
+            case pe_ucode::OP_HALT:
+                advance();
+                halted = true;
+                active_cycles--;
+                return false;
+            default:
+                break;
+        }
+
+        if (pe_ucode::needs_operand(w) && !opnd_count) return stall(STALL_OPERAND);
+
+        instr = w;
+        if (pe_ucode::needs_operand(w)) {
+            op = opnd_fifo[opnd_head];
+            opnd_head = (opnd_head + 1) % cfg.operand_depth;
+            opnd_count--;
+        }
+        if (repeat_left > 1) repeat_left--;
+        else {
+            repeat_left = 0;
+            advance();
+        }
+        issued++;
+        return true;
+    }
+
+    // ========================================
+    // Status and statistics
+    // ========================================
+    bool is_halted() const { return halted; }
+    // Nothing buffered or in flight: the program so far has fully issued
+    bool is_idle() const { return !instr_count && pc < 0 && capture_pos == capture_len; }
+    bool has_error() const { return !error.empty(); }
+    const std::string& error_message() const { return error; }
+    uint64_t issued_count() const { return issued; }
+    uint64_t stall_count(int reason) const { return stalls[reason]; }
+    uint64_t backpressure_cycles() const { return full_cycles; }
+
+    // Issued instructions per cycle between reset and HALT
+    double utilization() const { return active_cycles ? (double)issued / active_cycles : 0.0; }
+
+    static const char* stall_name(int r) {
+        static const char* names[NUM_STALLS] = { "empty", "operand", "control" };
+        return names[r];
+    }
+
+    void report(std::ostream& os) const {
+        os << "pe_cmd: " << issued << " issued in " << active_cycles << " cycles ("
+           << std::fixed << std::setprecision(1) << utilization() * 100.0 << "% issue-slot utilization), "
+           << host_words << " host words, " << std::setprecision(2)
+           << (host_words ? (double)issued / host_words : 0.0) << " instr/word" << std::endl;
+        os << "  host backpressure: " << full_cycles << " cycles with the instruction FIFO full" << std::endl;
+        os << "  stalls:";
+        for (int r = 0; r < NUM_STALLS; r++) os << " " << stall_name(r) << "=" << stalls[r];
+        os << std::defaultfloat << std::endl;
+        if (has_error()) os << "  error: " << error << std::endl;
+    }
+
+private:
+    struct loop_frame {
+        int start;                  // First body word in loop_buf
+        int end;                    // One past the last body word
+        int left;                   // Passes still to run
+    };
+
+    pe_cmd_config cfg;
+    std::vector<uint32_t> instr_fifo;
+    std::vector<OPERAND> opnd_fifo;
+    std::vector<uint32_t> loop_buf;
+    std::vector<loop_frame> loops;
+    int instr_head, instr_count;
+    int opnd_head, opnd_count;
+    int capture_len, capture_pos;
+    int loop_sp;
+    int pc;                         // Index into loop_buf, -1 = issuing from the FIFO
+    int repeat_left;
+    bool halted;
+    std::string error;
+
+    uint64_t cycles, issued, host_words, active_cycles;
+    uint64_t full_cycles;           // Cycles ready_out was low
+    uint64_t stalls[NUM_STALLS];
+
+    bool stall(int reason) {
+        stalls[reason]++;
+        return false;
+    }
+
+    uint32_t pop_instr() {
+        uint32_t w = instr_fifo[instr_head];
+        instr_head = (instr_head + 1) % cfg.instr_depth;
+        instr_count--;
+        return w;
+    }
+
+    bool peek(uint32_t& w) const {
+        if (pc >= 0) {
+            w = loop_buf[pc];
+            return true;
+        }
+        if (!instr_count) return false;
+        w = instr_fifo[instr_head];
+        return true;
+    }
+
+    // Move past the current word; close finished loop passes
+    void advance() {
+        if (pc < 0) {
+            pop_instr();
+            return;
+        }
+        pc++;
+        while (loop_sp > 0 && pc == loops[loop_sp - 1].end) {
+            loop_frame& f = loops[loop_sp - 1];
+            if (--f.left > 0) {
+                pc = f.start;
+                break;
+            }
+            loop_sp--;
+        }
+        if (loop_sp == 0) pc = -1;
+    }
+
+    // The LOOP word itself is consumed here
+    void enter_loop(uint32_t w) {
+        const int body = (int)((w >> 16) & 0xFF);
+        const int count = (int)(w & 0xFFFF);
+        if (pc < 0) pop_instr();
+        if (body == 0 || count == 0) {
+            fail("empty loop");
+        } else if (loop_sp == cfg.loop_depth) {
+            fail("loop nesting deeper than loop_depth");
+        } else if (pc < 0) {
+            // Outermost loop: capture the body from the host stream first
+            if (body > cfg.loop_buffer) {
+                fail("loop body larger than loop_buffer");
+                return;
+            }
+            capture_len = body;
+            capture_pos = 0;
+            loops[loop_sp++] = loop_frame{ 0, body, count };
+        } else if (pc + 1 + body > loops[loop_sp - 1].end) {
+            fail("inner loop runs past the enclosing loop body");
+        } else {
+            pc++;
+            loops[loop_sp++] = loop_frame{ pc, pc + body, count };
+        }
+    }
+
+    void fail(const char* msg) {
+        error = msg;
+        halted = true;
+    }
+};
+
+#endif // PE_CMD_QUEUE_H
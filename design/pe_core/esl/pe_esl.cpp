@@ -0,0 +1,440 @@
+// PE ESL Model - C API implementation (libpe_esl.so)
+// pe_cmd_queue + pe_batch_engine stepped on a worker thread per model
+//
+// The library does not use the SystemC kernel: it is a per-process singleton
+// that cannot be re-elaborated, so it could not host independent models or be
+// created and destroyed from a framework harness. pe_batch_engine is the
+// cycle-equivalent pure C++ datapath of pe_top_sc, and pe_cmd_queue is the
+// command processor of pe_cmd_proc_sc, so results and cycle counts match the
+// SystemC models.
+
+#include "pe_esl.h"
+#include "pe_batch_engine.h"
+#include "pe_cmd_queue.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+
+const int DATA_WIDTH = 32;
+const int MAC_ROWS = 8;
+const int MAC_COLS = 8;
+
+// Instructions that append an output beat (see pe_esl.h)
+bool has_output(uint32_t w) {
+    const uint32_t sub = (w >> 24) & 0x3;
+    switch (w >> 28) {
+        case 1: return sub == 0 || sub == 3;
+        case 2: return (w & 0xFF) != 5 || sub == 3;
+        case 3: return true;
+        default: return false;
+    }
+}
+
+void set_error(pe_esl_batch& b, int status, const char* msg) {
+    b.status = status;
+    std::snprintf(b.error, sizeof(b.error), "%s", msg);
+}
+
+// Smallest struct_size accepted. pe_esl_config fields after struct_size all
+// have defaults; a batch must hold the version-1 fields, which the model
+// writes its results into. Fields appended later default when absent.
+const size_t CONFIG_MIN_SIZE = sizeof(uint32_t);
+const size_t BATCH_MIN_SIZE = offsetof(pe_esl_batch, error) + sizeof(pe_esl_batch::error);
+
+class model_core {
+public:
+    virtual ~model_core() {}
+    virtual void reset() = 0;
+    virtual void run(pe_esl_batch& batch, pe_esl_counters& counters) = 0;
+};
+
+template <int NUM_PES>
+class model_impl : public model_core {
+public:
+    typedef pe_batch_engine<DATA_WIDTH, MAC_ROWS, MAC_COLS, NUM_PES> engine_t;
+    typedef pe_cmd_queue<uint32_t> queue_t;   // Operand = beat index into data_b
+
+    explicit model_impl(const pe_cmd_config& cfg) : queue(cfg) {
+        std::memset(zeros, 0, sizeof(zeros));
+    }
+
+    void reset() override { engine.reset(); }
+
+    void run(pe_esl_batch& batch, pe_esl_counters& counters) override {
+        const size_t b_beat = (size_t)MAC_ROWS * NUM_PES;
+        const size_t w_beat = (size_t)MAC_COLS * NUM_PES;
+        const size_t w_beats = batch.weight_beats ? batch.weight_beats : 1;
+
+        queue.reset();
+        size_t next_word = 0, next_beat = 0;
+        uint64_t cycles = 0;
+        batch.status = PE_ESL_OK;
+        batch.out_beats = 0;
+
+        while (batch.program_words) {
+            // Host side: one instruction word and one operand beat per cycle
+            if (next_word < batch.program_words && queue.push_instr(batch.program[next_word])) next_word++;
+            if (next_beat < batch.data_beats && queue.push_operand((uint32_t)next_beat)) next_beat++;
+
+            const uint64_t empty_before = queue.stall_count(queue_t::STALL_EMPTY);
+            const uint64_t operand_before = queue.stall_count(queue_t::STALL_OPERAND);
+
+            uint32_t w = 0, beat = 0;
+            const bool issued = queue.step(true, w, beat);
+            for (int pe = 0; pe < NUM_PES; pe++) {
+                instr[pe] = issued ? w : 0;
+                valid[pe] = issued;
+            }
+            const int32_t* b = zeros;
+            const int32_t* wt = zeros;
+            if (issued && pe_ucode::needs_operand(w)) {
+                b = batch.data_b + beat * b_beat;
+                wt = batch.weight + (beat % w_beats) * w_beat;
+            }
+            engine.step(instr, valid, b, wt);
+            cycles++;
+
+            if (issued) {
+                switch (w >> 28) {
+                    case 1: counters.mac_beats++; break;
+                    case 2: counters.act_beats++; break;
+                    case 3: counters.norm_beats++; break;
+                }
+                if (has_output(w)) {
+                    if (batch.out_beats == batch.out_capacity) {
+                        set_error(batch, PE_ESL_ERR_OVERFLOW, "output buffer full");
+                        break;
+                    }
+                    int32_t* dst = batch.out + batch.out_beats * b_beat;
+                    for (int row = 0; row < MAC_ROWS; row++)
+                        std::memcpy(dst + row * NUM_PES, engine.select_output(w, row), NUM_PES * sizeof(int32_t));
+                    batch.out_beats++;
+                }
+            }
+
+            if (queue.has_error()) {
+                set_error(batch, PE_ESL_ERR_PROGRAM, queue.error_message().c_str());
+                break;
+            }
+            if (queue.is_halted()) break;
+            if (next_word == batch.program_words && queue.is_idle()) break;
+            if (next_beat == batch.data_beats &&
+                queue.stall_count(queue_t::STALL_OPERAND) != operand_before) {
+                set_error(batch, PE_ESL_ERR_UNDERRUN, "program needs more operand beats than supplied");
+                break;
+            }
+            if (next_word == batch.program_words &&
+                queue.stall_count(queue_t::STALL_EMPTY) != empty_before) {
+                set_error(batch, PE_ESL_ERR_PROGRAM, "program ends inside a loop body");
+                break;
+            }
+        }
+
+        batch.cycles = cycles;
+        counters.cycles += cycles;
+        counters.issued += queue.issued_count();
+        counters.stall_empty += queue.stall_count(queue_t::STALL_EMPTY);
+        counters.stall_operand += queue.stall_count(queue_t::STALL_OPERAND);
+        counters.stall_control += queue.stall_count(queue_t::STALL_CONTROL);
+    }
+
+private:
+    engine_t engine;
+    queue_t queue;
+    uint32_t instr[NUM_PES];
+    uint8_t valid[NUM_PES];
+    int32_t zeros[MAC_ROWS * NUM_PES > MAC_COLS * NUM_PES ? MAC_ROWS * NUM_PES : MAC_COLS * NUM_PES];
+};
+
+model_core* make_core(uint32_t num_pes, const pe_cmd_config& cfg) {
+    switch (num_pes) {
+        case 1:  return new model_impl<1>(cfg);
+        case 4:  return new model_impl<4>(cfg);
+        case 16: return new model_impl<16>(cfg);
+        case 64: return new model_impl<64>(cfg);
+        default: return nullptr;
+    }
+}
+
+// Queue entry; a null batch is a reset request
+struct work_item {
+    pe_esl_batch* batch;
+    uint64_t ticket;
+};
+
+// A pe_esl_wait() caller blocked on one batch. The worker hands it the
+// status, since on_done may already have freed the batch.
+struct waiter {
+    int status;
+    int refs;
+    bool done;
+};
+
+} // namespace
+
+struct pe_esl_model {
+    std::unique_ptr<model_core> core;
+
+    std::mutex mu;
+    std::condition_variable work_cv;
+    std::condition_variable done_cv;
+    std::deque<work_item> pending;
+    std::unordered_map<pe_esl_batch*, uint64_t> in_flight;  // Submitted, callback not yet returned
+    std::unordered_map<uint64_t, waiter> waiters;           // pe_esl_wait() callers, by ticket
+    uint64_t next_ticket = 0;
+    bool stopping = false;
+    bool busy = false;                                      // Worker holds a popped item
+    pe_esl_counters counters;
+
+    std::thread worker;
+
+    void worker_loop() {
+        for (;;) {
+            work_item item;
+            {
+                std::unique_lock<std::mutex> lock(mu);
+                work_cv.wait(lock, [this] { return stopping || !pending.empty(); });
+                if (pending.empty()) return;
+                item = pending.front();
+                pending.pop_front();
+                busy = true;
+                if (stopping && item.batch) set_error(*item.batch, PE_ESL_ERR_CANCELLED, "model destroyed");
+            }
+
+            pe_esl_batch* b = item.batch;
+            if (!b) {
+                core->reset();
+            } else if (b->status == PE_ESL_PENDING) {
+                pe_esl_counters delta;
+                std::memset(&delta, 0, sizeof(delta));
+                auto t0 = std::chrono::steady_clock::now();
+                try {
+                    core->run(*b, delta);
+                } catch (const std::bad_alloc&) {
+                    set_error(*b, PE_ESL_ERR_NOMEM, "out of memory");
+                }
+                delta.busy_ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - t0).count();
+                std::lock_guard<std::mutex> lock(mu);
+                accumulate(delta, b->status == PE_ESL_OK);
+            }
+
+            // The callback may free the batch: read its status first and do
+            // not touch it afterwards. Waiters are released after it returns.
+            const int status = b ? b->status : PE_ESL_OK;
+            if (b && b->on_done) b->on_done(b, b->user);
+            {
+                std::lock_guard<std::mutex> lock(mu);
+                if (b) {
+                    in_flight.erase(b);
+                    auto w = waiters.find(item.ticket);
+                    if (w != waiters.end()) {
+                        w->second.status = status;
+                        w->second.done = true;
+                    }
+                }
+                busy = false;
+            }
+            done_cv.notify_all();
+        }
+    }
+
+    void accumulate(const pe_esl_counters& d, bool ok) {
+        counters.cycles += d.cycles;
+        counters.issued += d.issued;
+        counters.mac_beats += d.mac_beats;
+        counters.act_beats += d.act_beats;
+        counters.norm_beats += d.norm_beats;
+        counters.stall_empty += d.stall_empty;
+        counters.stall_operand += d.stall_operand;
+        counters.stall_control += d.stall_control;
+        counters.busy_ns += d.busy_ns;
+        if (ok) counters.batches_ok++;
+        else counters.batches_failed++;
+    }
+
+    bool idle() const { return pending.empty() && in_flight.empty() && !busy; }
+};
+
+extern "C" {
+
+int pe_esl_api_version(void) { return PE_ESL_API_VERSION; }
+
+const char* pe_esl_status_string(int status) {
+    switch (status) {
+        case PE_ESL_OK:            return "ok";
+        case PE_ESL_PENDING:       return "pending";
+        case PE_ESL_ERR_ARG:       return "invalid argument";
+        case PE_ESL_ERR_PROGRAM:   return "malformed program";
+        case PE_ESL_ERR_UNDERRUN:  return "operand underrun";
+        case PE_ESL_ERR_OVERFLOW:  return "output overflow";
+        case PE_ESL_ERR_CANCELLED: return "cancelled";
+        case PE_ESL_ERR_TIMEOUT:   return "timeout";
+        case PE_ESL_ERR_NOMEM:     return "out of memory or threads";
+        default:                   return "unknown status";
+    }
+}
+
+int pe_esl_mac_rows(void) { return MAC_ROWS; }
+int pe_esl_mac_cols(void) { return MAC_COLS; }
+
+void pe_esl_config_init(pe_esl_config* cfg) {
+    if (!cfg) return;
+    const pe_cmd_config d;
+    cfg->struct_size = sizeof(pe_esl_config);
+    cfg->num_pes = 1;
+    cfg->instr_depth = (uint32_t)d.instr_depth;
+    cfg->operand_depth = (uint32_t)d.operand_depth;
+    cfg->loop_buffer = (uint32_t)d.loop_buffer;
+    cfg->loop_depth = (uint32_t)d.loop_depth;
+}
+
+int pe_esl_create(const pe_esl_config* cfg, pe_esl_model** model) {
+    if (!model) return PE_ESL_ERR_ARG;
+    *model = nullptr;
+    pe_esl_config c;
+    pe_esl_config_init(&c);
+    if (cfg) {
+        // Copy the fields the caller's struct has; the rest keep their defaults
+        if (cfg->struct_size < CONFIG_MIN_SIZE) return PE_ESL_ERR_ARG;
+        std::memcpy(&c, cfg, cfg->struct_size < sizeof(c) ? cfg->struct_size : sizeof(c));
+    }
+    if (!c.instr_depth || !c.operand_depth || !c.loop_buffer || !c.loop_depth) return PE_ESL_ERR_ARG;
+
+    pe_cmd_config qcfg;
+    qcfg.instr_depth = (int)c.instr_depth;
+    qcfg.operand_depth = (int)c.operand_depth;
+    qcfg.loop_buffer = (int)c.loop_buffer;
+    qcfg.loop_depth = (int)c.loop_depth;
+
+    // No exception may cross the C ABI: allocation and thread start failures
+    // are reported as PE_ESL_ERR_NOMEM
+    try {
+        std::unique_ptr<pe_esl_model> m(new pe_esl_model);
+        m->core.reset(make_core(c.num_pes, qcfg));
+        if (!m->core) return PE_ESL_ERR_ARG;
+        std::memset(&m->counters, 0, sizeof(m->counters));
+        m->worker = std::thread(&pe_esl_model::worker_loop, m.get());
+        *model = m.release();
+        return PE_ESL_OK;
+    } catch (const std::bad_alloc&) {
+        return PE_ESL_ERR_NOMEM;
+    } catch (const std::system_error&) {
+        return PE_ESL_ERR_NOMEM;
+    }
+}
+
+void pe_esl_destroy(pe_esl_model* model) {
+    if (!model) return;
+    {
+        std::lock_guard<std::mutex> lock(model->mu);
+        model->stopping = true;
+    }
+    model->work_cv.notify_all();
+    model->worker.join();
+    delete model;
+}
+
+int pe_esl_submit(pe_esl_model* model, pe_esl_batch* batch) {
+    if (!model || !batch) return PE_ESL_ERR_ARG;
+    if (batch->struct_size < BATCH_MIN_SIZE) return PE_ESL_ERR_ARG;
+    if (batch->program_words && !batch->program) return PE_ESL_ERR_ARG;
+    if (batch->data_beats && (!batch->data_b || !batch->weight)) return PE_ESL_ERR_ARG;
+    if (batch->out_capacity && !batch->out) return PE_ESL_ERR_ARG;
+    if (batch->data_beats > UINT32_MAX) return PE_ESL_ERR_ARG;
+    {
+        std::lock_guard<std::mutex> lock(model->mu);
+        const uint64_t ticket = model->next_ticket;
+        if (model->stopping) return PE_ESL_ERR_ARG;
+        try {
+            auto slot = model->in_flight.emplace(batch, ticket);
+            if (!slot.second) return PE_ESL_ERR_ARG;
+            try {
+                model->pending.push_back(work_item{ batch, ticket });
+            } catch (...) {
+                model->in_flight.erase(slot.first);
+                throw;
+            }
+        } catch (const std::bad_alloc&) {
+            return PE_ESL_ERR_NOMEM;
+        }
+        model->next_ticket++;
+        batch->status = PE_ESL_PENDING;
+        batch->out_beats = 0;
+        batch->cycles = 0;
+        batch->error[0] = '\0';
+    }
+    model->work_cv.notify_one();
+    return PE_ESL_OK;
+}
+
+int pe_esl_wait(pe_esl_model* model, pe_esl_batch* batch, int timeout_ms) {
+    if (!model) return PE_ESL_ERR_ARG;
+    std::unique_lock<std::mutex> lock(model->mu);
+    if (!batch) {
+        auto idle = [model] { return model->idle(); };
+        if (timeout_ms < 0) model->done_cv.wait(lock, idle);
+        else if (!model->done_cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), idle))
+            return PE_ESL_ERR_TIMEOUT;
+        return PE_ESL_OK;
+    }
+
+    // Already complete: the batch is back in the caller's hands
+    auto it = model->in_flight.find(batch);
+    if (it == model->in_flight.end()) return batch->status;
+
+    // Still in flight: the worker reports the status, and the batch itself is
+    // not read again in case on_done freed it
+    const uint64_t ticket = it->second;
+    waiter* wp;
+    try {
+        wp = &model->waiters[ticket];
+    } catch (const std::bad_alloc&) {
+        return PE_ESL_ERR_NOMEM;
+    }
+    waiter& w = *wp;
+    w.refs++;
+    auto done = [&w] { return w.done; };
+    bool finished = true;
+    if (timeout_ms < 0) model->done_cv.wait(lock, done);
+    else finished = model->done_cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), done);
+    const int status = finished ? w.status : PE_ESL_ERR_TIMEOUT;
+    if (--w.refs == 0) model->waiters.erase(ticket);
+    return status;
+}
+
+int pe_esl_reset(pe_esl_model* model) {
+    if (!model) return PE_ESL_ERR_ARG;
+    {
+        std::lock_guard<std::mutex> lock(model->mu);
+        if (model->stopping) return PE_ESL_ERR_ARG;
+        try {
+            model->pending.push_back(work_item{ nullptr, 0 });
+        } catch (const std::bad_alloc&) {
+            return PE_ESL_ERR_NOMEM;
+        }
+    }
+    model->work_cv.notify_one();
+    return PE_ESL_OK;
+}
+
+int pe_esl_get_counters(pe_esl_model* model, pe_esl_counters* counters, size_t size) {
+    if (!model || !counters) return PE_ESL_ERR_ARG;
+    std::lock_guard<std::mutex> lock(model->mu);
+    std::memcpy(counters, &model->counters, size < sizeof(pe_esl_counters) ? size : sizeof(pe_esl_counters));
+    return PE_ESL_OK;
+}
+
+} // extern "C"
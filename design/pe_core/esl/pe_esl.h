@@ -0,0 +1,155 @@
+/*
+ * PE ESL Model - C API (libpe_esl.so)
+ * Embeds the cycle-level PE model in another process
+ *
+ * A model is NUM_PES PEs driven in lockstep by one command queue (the
+ * pe_batch_engine datapath behind pe_cmd_queue). The host submits batches:
+ * a program of instruction words (LOOP/REPEAT/HALT allowed) plus operand and
+ * output tensors the caller owns. The model reads the operands in place and
+ * writes results straight into the output buffer; nothing is copied or
+ * serialized at submit time. Batches run in order on a thread owned by the
+ * model. Completion is reported through an optional callback (called on that
+ * thread) and pe_esl_wait().
+ *
+ * Only num_pes is selectable (1, 4, 16 or 64). The PE shape is fixed at
+ * DATA_WIDTH 32 with an 8x8 MAC array, the configuration the SystemC
+ * testbenches use; pe_esl_mac_rows()/pe_esl_mac_cols() report it. Each
+ * num_pes is a separate pe_batch_engine instantiation compiled into the
+ * library, so other shapes need a rebuild with their own instantiations.
+ *
+ * Tensor layout (all int32, one lane per PE per row, lane-major):
+ *   data_b  beat k: data_b[(k * mac_rows + row) * num_pes + pe]
+ *   weight  beat k: weight[((k % weight_beats) * mac_cols + col) * num_pes + pe]
+ *   out     beat j: out[(j * mac_rows + row) * num_pes + pe]
+ * Every passthrough and MAC LOAD/ACC instruction consumes one data_b/weight
+ * beat, as in pe_cmd_proc_sc; MAC CLEAR/DRAIN take none. MAC LOAD/DRAIN, NORM
+ * and ACT (except softmax statistics steps) each append one output beat, in
+ * issue order.
+ *
+ * Buffers and the batch struct must stay valid until on_done returns (or, with
+ * no callback, until pe_esl_wait() reports the batch done). The model does not
+ * touch a batch after its callback, so on_done may free it. Once it does, wait
+ * on that batch only from a pe_esl_wait() call made before the callback ran, or
+ * wait with a NULL batch. All functions are thread-safe except
+ * pe_esl_destroy().
+ */
+
+#ifndef PE_ESL_H
+#define PE_ESL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#define PE_ESL_API __declspec(dllexport)
+#else
+#define PE_ESL_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Bumped on incompatible changes. Structs only grow at the end: the library
+ * reads the fields a caller's struct_size covers and defaults the rest, so an
+ * older, shorter struct is accepted. A batch must hold at least the
+ * version-1 fields, since the model writes its results there. */
+#define PE_ESL_API_VERSION 1
+
+/* Status codes */
+#define PE_ESL_OK                0
+#define PE_ESL_PENDING           1  /* Submitted, not finished */
+#define PE_ESL_ERR_ARG          -1  /* Bad argument or unsupported num_pes */
+#define PE_ESL_ERR_PROGRAM      -2  /* Malformed program (loop error, truncated body) */
+#define PE_ESL_ERR_UNDERRUN     -3  /* Program needs more operand beats than supplied */
+#define PE_ESL_ERR_OVERFLOW     -4  /* Output buffer too small */
+#define PE_ESL_ERR_CANCELLED    -5  /* Model destroyed before the batch ran */
+#define PE_ESL_ERR_TIMEOUT      -6  /* pe_esl_wait() timed out */
+#define PE_ESL_ERR_NOMEM        -7  /* Out of memory, or the model thread could not start */
+
+typedef struct pe_esl_model pe_esl_model;
+
+typedef struct pe_esl_config {
+    uint32_t struct_size;       /* sizeof(pe_esl_config), set by pe_esl_config_init() */
+    uint32_t num_pes;           /* 1, 4, 16 or 64; the PE shape is fixed (see above) */
+    uint32_t instr_depth;       /* Instruction FIFO entries */
+    uint32_t operand_depth;     /* Operand FIFO entries */
+    uint32_t loop_buffer;       /* Captured loop body words */
+    uint32_t loop_depth;        /* Nested loop levels */
+} pe_esl_config;
+
+struct pe_esl_batch;
+typedef void (*pe_esl_callback)(struct pe_esl_batch* batch, void* user);
+
+typedef struct pe_esl_batch {
+    /* Set by the caller */
+    uint32_t struct_size;       /* sizeof(pe_esl_batch), at least the version-1 size */
+    const uint32_t* program;
+    size_t program_words;
+    const int32_t* data_b;
+    size_t data_beats;
+    const int32_t* weight;
+    size_t weight_beats;        /* 0 is treated as 1 */
+    int32_t* out;
+    size_t out_capacity;        /* In beats */
+    pe_esl_callback on_done;    /* Optional, runs on the model thread */
+    void* user;
+
+    /* Set by the model */
+    int status;
+    size_t out_beats;
+    uint64_t cycles;
+    char error[96];
+} pe_esl_batch;
+
+typedef struct pe_esl_counters {
+    uint64_t cycles;            /* Clock edges simulated */
+    uint64_t issued;            /* Datapath instructions issued */
+    uint64_t mac_beats;
+    uint64_t act_beats;
+    uint64_t norm_beats;
+    uint64_t stall_empty;       /* pe_cmd_queue stall reasons */
+    uint64_t stall_operand;
+    uint64_t stall_control;
+    uint64_t batches_ok;
+    uint64_t batches_failed;
+    uint64_t busy_ns;           /* Wall-clock time spent simulating */
+} pe_esl_counters;
+
+PE_ESL_API int pe_esl_api_version(void);
+PE_ESL_API const char* pe_esl_status_string(int status);
+
+/* Model shape for the tensor layouts above */
+PE_ESL_API int pe_esl_mac_rows(void);
+PE_ESL_API int pe_esl_mac_cols(void);
+
+PE_ESL_API void pe_esl_config_init(pe_esl_config* cfg);
+
+/* Returns PE_ESL_OK and sets *model, or an error code */
+PE_ESL_API int pe_esl_create(const pe_esl_config* cfg, pe_esl_model** model);
+
+/* Cancels queued batches (callbacks still run), finishes the running one */
+PE_ESL_API void pe_esl_destroy(pe_esl_model* model);
+
+/* Queue a batch; its status is PE_ESL_PENDING until it completes.
+ * PE_ESL_ERR_ARG if struct_size is too small or the batch is already queued. */
+PE_ESL_API int pe_esl_submit(pe_esl_model* model, pe_esl_batch* batch);
+
+/* Wait for one batch (or all submitted batches when batch is NULL).
+ * timeout_ms < 0 waits forever, 0 polls. Returns the batch status,
+ * PE_ESL_OK for all batches, or PE_ESL_ERR_TIMEOUT. A wait that starts
+ * before the batch completes takes the status from the model, not the
+ * batch, so it is safe if on_done frees the batch. */
+PE_ESL_API int pe_esl_wait(pe_esl_model* model, pe_esl_batch* batch, int timeout_ms);
+
+/* Clear accumulators and pipeline registers once queued batches finish */
+PE_ESL_API int pe_esl_reset(pe_esl_model* model);
+
+/* Copies min(size, sizeof(pe_esl_counters)) bytes */
+PE_ESL_API int pe_esl_get_counters(pe_esl_model* model, pe_esl_counters* counters, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PE_ESL_H */
@@ -34,6 +34,8 @@ public:
     sc_signal<bool> mac_enable;
     sc_signal<bool> activation_enable;
     sc_signal<bool> norm_enable;
+    sc_signal<sc_uint<2>> mac_op;
+    sc_signal<sc_uint<2>> act_op;
     sc_signal<sc_uint<8>> activation_type;
     sc_signal<sc_uint<8>> norm_type;
     
@@ -54,6 +56,7 @@ public:
         u_mac_array->clk(clk);
         u_mac_array->rst_n(rst_n);
         u_mac_array->enable(mac_enable);
+        u_mac_array->mac_op(mac_op);
         u_mac_array->data_a_i(data_a_i);
         u_mac_array->data_b_i(data_b_i);
         u_mac_array->weight_i(weight_i);
@@ -64,6 +67,7 @@ public:
         u_activation->rst_n(rst_n);
         u_activation->enable(activation_enable);
         u_activation->activation_type(activation_type);
+        u_activation->act_op(act_op);
         u_activation->data_i(activation_input);
         u_activation->data_o(activation_result_sig);
         
@@ -75,8 +79,10 @@ public:
         u_normalization->data_i(activation_result_sig);
         u_normalization->data_o(norm_result_sig);
         
+        // mac_result_sig feeds activation_input, so it must be re-sampled
+        // whenever the MAC register changes, not only on a new instruction
         SC_METHOD(decode_instruction);
-        sensitive << instruction;
+        sensitive << instruction << valid_in << rst_n << mac_result_sig;
         dont_initialize();
         
         SC_METHOD(output_mux);
@@ -96,9 +102,13 @@ private:
         sc_uint<32> instr = instruction.read();
         sc_uint<4> opcode = instr.range(31, 28);
         
-        mac_enable.write(opcode == 1);
-        activation_enable.write(opcode == 2);
+        // MAC and activation only advance on valid beats so ACC and the
+        // softmax running state count issued instructions
+        mac_enable.write(opcode == 1 && valid_in.read());
+        activation_enable.write(opcode == 2 && valid_in.read());
         norm_enable.write(opcode == 3);
+        mac_op.write(instr.range(25, 24));
+        act_op.write(instr.range(25, 24));
         
         activation_type.write(instr.range(7, 0));
         norm_type.write(instr.range(7, 0));
@@ -112,7 +122,9 @@ private:
             activation_input.write(mac_result_sig.read());
         }
         
-        ready_out.write(true);
+        // Single-issue datapath: accepts a beat every cycle once out of reset.
+        // Queueing and backpressure live in pe_cmd_proc_sc.
+        ready_out.write(rst_n.read());
     }
     
     void output_mux() {
@@ -122,44 +134,30 @@ private:
         }
         
         sc_bv<DATA_WIDTH * VECTOR_WIDTH> output_packed;
-        
-        // Zero initialize
-        for (int i = 0; i < DATA_WIDTH * VECTOR_WIDTH; i++) {
-            output_packed.write()[i] = 0;
-        }
-        
+        sc_bv<DATA_WIDTH * MAC_ROWS> stage_out;
+
         if (norm_enable.read()) {
             // Output from normalization unit
-            sc_bv<DATA_WIDTH * MAC_ROWS> norm_out = norm_result_sig.read();
-            for (int i = 0; i < MAC_ROWS && i < VECTOR_WIDTH; i++) {
-                for (int bit = 0; bit < DATA_WIDTH; bit++) {
-                    output_packed.write()[i * DATA_WIDTH + bit] = norm_out.read()[i * DATA_WIDTH + bit];
-                }
-            }
-            valid_out.write(true);
+            stage_out = norm_result_sig.read();
         } else if (activation_enable.read()) {
             // Output from activation unit
-            sc_bv<DATA_WIDTH * MAC_ROWS> act_out = activation_result_sig.read();
-            for (int i = 0; i < MAC_ROWS && i < VECTOR_WIDTH; i++) {
-                for (int bit = 0; bit < DATA_WIDTH; bit++) {
-                    output_packed.write()[i * DATA_WIDTH + bit] = act_out.read()[i * DATA_WIDTH + bit];
-                }
-            }
-            valid_out.write(true);
+            stage_out = activation_result_sig.read();
         } else if (mac_enable.read()) {
             // Output from MAC array
-            sc_bv<DATA_WIDTH * MAC_ROWS> mac_out = mac_result_sig.read();
-            for (int i = 0; i < MAC_ROWS && i < VECTOR_WIDTH; i++) {
-                for (int bit = 0; bit < DATA_WIDTH; bit++) {
-                    output_packed.write()[i * DATA_WIDTH + bit] = mac_out.read()[i * DATA_WIDTH + bit];
-                }
-            }
-            valid_out.write(true);
+            stage_out = mac_result_sig.read();
         } else {
             // Passthrough
             result_o.write(data_a_i.read());
             valid_out.write(valid_in.read());
+            return;
+        }
+
+        for (int i = 0; i < MAC_ROWS && i < VECTOR_WIDTH; i++) {
+            output_packed.range(i * DATA_WIDTH + DATA_WIDTH - 1, i * DATA_WIDTH) =
+                stage_out.range(i * DATA_WIDTH + DATA_WIDTH - 1, i * DATA_WIDTH).to_uint();
         }
+        result_o.write(output_packed);
+        valid_out.write(true);
     }
 };
 
@@ -0,0 +1,192 @@
+// Banked Share Memory Arbiter (ESL)
+// Bank mapping, per-bank arbitration and contention statistics
+//
+// The RTL share_memory.v is a single array where the PE always wins over
+// AXI. This model splits the array into num_banks single-ported banks. Each
+// bank serves one access per cycle, so requesters that hit different banks
+// proceed in parallel. No SystemC dependency; share_memory_sc.h wraps it
+// behind the RTL port list.
+
+#ifndef SHARE_MEMORY_ARBITER_H
+#define SHARE_MEMORY_ARBITER_H
+
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <ostream>
+#include <iomanip>
+
+// Bank interleaving functions
+enum share_memory_interleave {
+    INTERLEAVE_LOW = 0,     // bank = addr % banks (word interleaved)
+    INTERLEAVE_HIGH = 1,    // bank = addr / ceil(depth / banks) (contiguous regions)
+    INTERLEAVE_XOR = 2      // bank = (addr ^ (addr / banks)) % banks
+};
+
+// Per-bank arbitration policies
+enum share_memory_policy {
+    ARB_FIXED_PRIORITY = 0, // Lowest requester index wins (PE over AXI, as in RTL)
+    ARB_ROUND_ROBIN = 1,    // Rotate priority per bank after each grant
+    ARB_AGE_BASED = 2       // Longest-waiting request wins, ties by index
+};
+
+struct share_memory_config {
+    int depth = 256;
+    int num_banks = 1;
+    int interleave = INTERLEAVE_LOW;
+    int policy = ARB_FIXED_PRIORITY;
+    int num_requesters = 2;             // 0 = PE, 1 = AXI
+    int histogram_bins = 16;            // Last bin collects longer waits
+
+    bool valid(std::string* err) const {
+        if (depth < 1)
+            return fail("depth must be positive", err);
+        if (num_banks < 1 || num_banks > depth)
+            return fail("num_banks must be between 1 and depth", err);
+        if (interleave < INTERLEAVE_LOW || interleave > INTERLEAVE_XOR)
+            return fail("unknown interleave", err);
+        if (policy < ARB_FIXED_PRIORITY || policy > ARB_AGE_BASED)
+            return fail("unknown arbitration policy", err);
+        if (num_requesters < 1 || histogram_bins < 1)
+            return fail("num_requesters and histogram_bins must be positive", err);
+        return true;
+    }
+
+private:
+    static bool fail(const char* msg, std::string* err) {
+        if (err) *err = msg;
+        return false;
+    }
+};
+
+class share_memory_arbiter {
+public:
+    struct requester_stats {
+        uint64_t requests;              // Accesses completed
+        uint64_t stall_cycles;          // Cycles spent requesting without a grant
+        uint64_t bank_conflicts;        // Accesses delayed by another requester on the same bank
+        std::vector<uint64_t> latency_hist;  // Grant latency in cycles (1 = no wait)
+    };
+
+    // cfg must pass share_memory_config::valid()
+    explicit share_memory_arbiter(const share_memory_config& cfg = share_memory_config())
+        : cfg(cfg)
+        , words_per_bank((cfg.depth + cfg.num_banks - 1) / cfg.num_banks)
+        , rr_next(cfg.num_banks, 0)
+        , wait_cycles(cfg.num_requesters, 0)
+        , winner(cfg.num_banks, -1)
+        , stats(cfg.num_requesters) {
+        reset();
+    }
+
+    void reset() {
+        for (int b = 0; b < cfg.num_banks; b++) rr_next[b] = 0;
+        for (int r = 0; r < cfg.num_requesters; r++) {
+            wait_cycles[r] = 0;
+            stats[r].requests = 0;
+            stats[r].stall_cycles = 0;
+            stats[r].bank_conflicts = 0;
+            stats[r].latency_hist.assign(cfg.histogram_bins, 0);
+        }
+        cycles = 0;
+    }
+
+    // Always below num_banks. With INTERLEAVE_HIGH and a bank count that does
+    // not divide depth, the last bank is the short one.
+    int bank_of(uint32_t addr) const {
+        const uint32_t a = addr % (uint32_t)cfg.depth;
+        switch (cfg.interleave) {
+            case INTERLEAVE_HIGH: return (int)(a / words_per_bank);
+            case INTERLEAVE_XOR:  return (int)((a ^ (a / cfg.num_banks)) % cfg.num_banks);
+            default:              return (int)(a % cfg.num_banks);
+        }
+    }
+
+    // One clock edge. request[r]/addr[r] are sampled; grant[r] is set for
+    // every requester whose access is performed this cycle.
+    void step(const bool* request, const uint32_t* addr, bool* grant) {
+        cycles++;
+        for (int b = 0; b < cfg.num_banks; b++) winner[b] = -1;
+
+        for (int r = 0; r < cfg.num_requesters; r++) {
+            grant[r] = false;
+            if (!request[r]) continue;
+            const int b = bank_of(addr[r]);
+            if (winner[b] < 0 || beats(r, winner[b], b)) winner[b] = r;
+        }
+
+        for (int r = 0; r < cfg.num_requesters; r++) {
+            if (!request[r]) continue;
+            const int b = bank_of(addr[r]);
+            if (winner[b] == r) {
+                grant[r] = true;
+                stats[r].requests++;
+                int bin = wait_cycles[r] < cfg.histogram_bins - 1 ? wait_cycles[r]
+                                                                  : cfg.histogram_bins - 1;
+                stats[r].latency_hist[bin]++;
+                if (wait_cycles[r] > 0) stats[r].bank_conflicts++;
+                wait_cycles[r] = 0;
+                rr_next[b] = (r + 1) % cfg.num_requesters;
+            } else {
+                stats[r].stall_cycles++;
+                wait_cycles[r]++;
+            }
+        }
+    }
+
+    uint64_t cycle_count() const { return cycles; }
+    const requester_stats& requester(int r) const { return stats[r]; }
+    const share_memory_config& config() const { return cfg; }
+
+    static const char* interleave_name(int i) {
+        return i == INTERLEAVE_HIGH ? "high" : (i == INTERLEAVE_XOR ? "xor" : "low");
+    }
+
+    static const char* policy_name(int p) {
+        return p == ARB_ROUND_ROBIN ? "round-robin" : (p == ARB_AGE_BASED ? "age" : "fixed");
+    }
+
+    void report(std::ostream& os, const char* const* names = nullptr) const {
+        os << "share_memory: " << cfg.num_banks << " bank(s), "
+           << interleave_name(cfg.interleave) << " interleave, "
+           << policy_name(cfg.policy) << " arbitration, " << cycles << " cycles" << std::endl;
+        for (int r = 0; r < cfg.num_requesters; r++) {
+            const requester_stats& s = stats[r];
+            os << "  " << std::setw(4) << (names ? names[r] : std::to_string(r).c_str())
+               << ": " << s.requests << " accesses, " << s.stall_cycles << " stall cycles, "
+               << s.bank_conflicts << " bank conflicts" << std::endl;
+            os << "        grant latency:";
+            for (int i = 0; i < cfg.histogram_bins; i++) {
+                if (!s.latency_hist[i]) continue;
+                os << " " << (i + 1) << (i == cfg.histogram_bins - 1 ? "+" : "")
+                   << ":" << s.latency_hist[i];
+            }
+            os << std::endl;
+        }
+    }
+
+private:
+    share_memory_config cfg;
+    int words_per_bank;
+    std::vector<int> rr_next;           // Round-robin pointer per bank
+    std::vector<int> wait_cycles;       // Cycles the current request has waited
+    std::vector<int> winner;
+    std::vector<requester_stats> stats;
+    uint64_t cycles;
+
+    // Does requester a win bank b over the current winner w?
+    bool beats(int a, int w, int b) const {
+        switch (cfg.policy) {
+            case ARB_ROUND_ROBIN: {
+                const int n = cfg.num_requesters;
+                return (a - rr_next[b] + n) % n < (w - rr_next[b] + n) % n;
+            }
+            case ARB_AGE_BASED:
+                return wait_cycles[a] > wait_cycles[w];
+            default:
+                return false;   // Requesters are scanned in priority order
+        }
+    }
+};
+
+#endif // SHARE_MEMORY_ARBITER_H
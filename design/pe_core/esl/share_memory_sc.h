@@ -0,0 +1,94 @@
+// Share Memory SystemC Model (ESL)
+// Banked version of share_memory.v with configurable arbitration
+//
+// Keeps the RTL port list (PE port + AXI port, request/grant handshake).
+// Requests are sampled on the rising edge; grant is high for the cycle after
+// the access is performed and rdata then holds the read value. A requester
+// that keeps request high during the grant cycle issues a new access, so
+// drivers should update their request on the falling edge.
+
+#ifndef SHARE_MEMORY_SC_H
+#define SHARE_MEMORY_SC_H
+
+#include <systemc.h>
+#include <vector>
+#include <string>
+#include "share_memory_arbiter.h"
+
+template <int DEPTH, int WIDTH, int ADDR_W>
+class share_memory_sc : public sc_module {
+public:
+    static const int PORT_PE = 0;
+    static const int PORT_AXI = 1;
+
+    // System
+    sc_in<bool> clk;
+    sc_in<bool> rst_n;
+
+    // Port 1: PE Access
+    sc_in<bool> pe_we;
+    sc_in<sc_uint<ADDR_W>> pe_addr;
+    sc_in<sc_uint<WIDTH>> pe_wdata;
+    sc_out<sc_uint<WIDTH>> pe_rdata;
+    sc_in<bool> pe_request;
+    sc_out<bool> pe_grant;
+
+    // Port 2: AXI Slave Access
+    sc_in<bool> axi_we;
+    sc_in<sc_uint<ADDR_W>> axi_addr;
+    sc_in<sc_uint<WIDTH>> axi_wdata;
+    sc_out<sc_uint<WIDTH>> axi_rdata;
+    sc_in<bool> axi_request;
+    sc_out<bool> axi_grant;
+
+    share_memory_sc(sc_module_name name, const share_memory_config& cfg = share_memory_config())
+        : sc_module(name)
+        , arbiter(with_depth(cfg))
+        , mem(DEPTH, 0) {
+        SC_HAS_PROCESS(share_memory_sc);
+        SC_METHOD(access_process);
+        sensitive << clk.pos();
+        dont_initialize();
+    }
+
+    const share_memory_arbiter& stats() const { return arbiter; }
+
+private:
+    share_memory_arbiter arbiter;
+    std::vector<sc_uint<WIDTH>> mem;
+
+    static share_memory_config with_depth(share_memory_config cfg) {
+        cfg.depth = DEPTH;
+        cfg.num_requesters = 2;
+        std::string err;
+        if (!cfg.valid(&err)) SC_REPORT_ERROR("share_memory_sc", err.c_str());
+        return cfg;
+    }
+
+    void access_process() {
+        if (!rst_n.read()) {
+            pe_grant.write(false);
+            axi_grant.write(false);
+            return;
+        }
+
+        const bool request[2] = { pe_request.read(), axi_request.read() };
+        const uint32_t addr[2] = { (uint32_t)pe_addr.read() % DEPTH,
+                                   (uint32_t)axi_addr.read() % DEPTH };
+        bool grant[2];
+        arbiter.step(request, addr, grant);
+
+        if (grant[PORT_PE]) {
+            if (pe_we.read()) mem[addr[PORT_PE]] = pe_wdata.read();
+            else pe_rdata.write(mem[addr[PORT_PE]]);
+        }
+        if (grant[PORT_AXI]) {
+            if (axi_we.read()) mem[addr[PORT_AXI]] = axi_wdata.read();
+            else axi_rdata.write(mem[addr[PORT_AXI]]);
+        }
+        pe_grant.write(grant[PORT_PE]);
+        axi_grant.write(grant[PORT_AXI]);
+    }
+};
+
+#endif // SHARE_MEMORY_SC_H
@@ -0,0 +1,179 @@
+// Online Softmax Kernels (ESL)
+// Streaming softmax shared by the activation models and a host SIMD kernel
+//
+// Online softmax keeps, per lane, a running maximum m and a sum s of
+// exp(x - m). Folding a new value x:
+//   m' = max(m, x),  s' = s * exp(m - m') + exp(x - m')
+// At the end of the row, the lanes are merged:
+//   M = max_l m_l,   S = sum_l s_l * exp(m_l - M)
+// Then a normalization pass emits exp(x - M) / S. The row is read twice
+// (stats, normalize) regardless of its length, so rows far longer than
+// VECTOR_WIDTH stream through the activation unit one beat at a time.
+// Masked scores (-inf) contribute nothing. A lane that has seen only -inf keeps
+// m = -inf, s = 0 and is never rescaled, because -inf - -inf is NaN. A fully
+// masked row has S = 0 and normalizes to all zeros. No SystemC dependency.
+
+#ifndef SOFTMAX_KERNEL_H
+#define SOFTMAX_KERNEL_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace softmax_kernel {
+
+// ========================================
+// Per-lane state used by the activation unit models
+// ========================================
+inline void lane_reset(double& m, double& s) {
+    m = -std::numeric_limits<double>::infinity();
+    s = 0.0;
+}
+
+inline void lane_fold(double& m, double& s, double x) {
+    const double mn = x > m ? x : m;
+    if (mn == -std::numeric_limits<double>::infinity()) return;    // Still empty
+    s = s * std::exp(m - mn) + std::exp(x - mn);
+    m = mn;
+}
+
+// Merge lane statistics into the row maximum and sum
+inline void lane_merge(const double* m, const double* s, int lanes, int stride,
+                       double& row_max, double& row_sum) {
+    row_max = -std::numeric_limits<double>::infinity();
+    for (int l = 0; l < lanes; l++) row_max = m[l * stride] > row_max ? m[l * stride] : row_max;
+    row_sum = 0.0;
+    for (int l = 0; l < lanes; l++) {
+        if (s[l * stride] > 0.0) row_sum += s[l * stride] * std::exp(m[l * stride] - row_max);
+    }
+}
+
+// Normalized output for one value of a merged row; 0 if the row was fully masked
+inline double lane_prob(double x, double row_max, double row_sum) {
+    return row_sum > 0.0 ? std::exp(x - row_max) / row_sum : 0.0;
+}
+
+// ========================================
+// Host kernels (FP32)
+// ========================================
+// Lanes of independent running state; a multiple of the host SIMD width
+const int LANES = 16;
+// Elements per lane folded with one rescale
+const int BLOCK = 8;
+
+// exp(x) for x <= 0 from 2^n * p(f), |f| <= 0.5 (Cephes exp2f polynomial,
+// ~2e-7 relative error). Branch-free so the row loops vectorize. n is rounded
+// with the 1.5 * 2^23 trick, which std::floor would block; do not build with
+// -ffast-math, which folds it away. x is clamped at -88, where n = -127 gives
+// a zero exponent field: the result underflows to exactly 0, including for
+// exp_approx(-inf).
+inline float exp_approx(float x) {
+    x = x < -88.0f ? -88.0f : x;
+    const float t = x * 1.44269504088896341f;
+    const float n = (t + 12582912.0f) - 12582912.0f;
+    const float f = t - n;
+    float p = 1.535336188319500e-4f;
+    p = p * f + 1.339887440266574e-3f;
+    p = p * f + 9.618437357674640e-3f;
+    p = p * f + 5.550332471162809e-2f;
+    p = p * f + 2.402264791363012e-1f;
+    p = p * f + 6.931472028550421e-1f;
+    p = p * f + 1.0f;
+    const int32_t bits = ((int32_t)n + 127) << 23;
+    float scale;
+    std::memcpy(&scale, &bits, sizeof(scale));
+    return p * scale;
+}
+
+// Value subtracted before exp_approx: 0 for an empty (-inf) running max, so a
+// masked x gives exp_approx(-inf) = 0 instead of exp_approx(NaN)
+inline float exp_base(float m) {
+    return m == -std::numeric_limits<float>::infinity() ? 0.0f : m;
+}
+
+// Double-precision three-pass reference
+inline void softmax_reference(const float* x, float* y, int n) {
+    double m = -std::numeric_limits<double>::infinity();
+    for (int i = 0; i < n; i++) m = x[i] > m ? x[i] : m;
+    if (m == -std::numeric_limits<double>::infinity()) {
+        for (int i = 0; i < n; i++) y[i] = 0.0f;
+        return;
+    }
+    double s = 0.0;
+    for (int i = 0; i < n; i++) s += std::exp((double)x[i] - m);
+    for (int i = 0; i < n; i++) y[i] = (float)(std::exp((double)x[i] - m) / s);
+}
+
+// Conventional FP32 softmax: max pass, exp + sum pass, scale pass
+inline void softmax_three_pass(const float* x, float* y, int n) {
+    float m = -std::numeric_limits<float>::infinity();
+    for (int i = 0; i < n; i++) m = x[i] > m ? x[i] : m;
+    m = exp_base(m);
+    float s = 0.0f;
+    for (int i = 0; i < n; i++) {
+        y[i] = exp_approx(x[i] - m);
+        s += y[i];
+    }
+    const float inv = s > 0.0f ? 1.0f / s : 0.0f;
+    for (int i = 0; i < n; i++) y[i] *= inv;
+}
+
+// Online FP32 softmax: one statistics pass over x, one normalization pass.
+// Each lane rescales its sum once per BLOCK elements rather than per element.
+inline void softmax_online(const float* x, float* y, int n) {
+    const int chunk = LANES * BLOCK;
+    if (n < chunk) {
+        // Row fits in a few cache lines; lane state costs more than it saves
+        softmax_three_pass(x, y, n);
+        return;
+    }
+
+    alignas(64) float m[LANES];
+    alignas(64) float s[LANES];
+    for (int l = 0; l < LANES; l++) {
+        m[l] = -std::numeric_limits<float>::infinity();
+        s[l] = 0.0f;
+    }
+
+    int i = 0;
+    for (; i + chunk <= n; i += chunk) {
+        alignas(64) float bm[LANES];
+        for (int l = 0; l < LANES; l++) bm[l] = m[l];
+        for (int b = 0; b < BLOCK; b++)
+            for (int l = 0; l < LANES; l++) {
+                const float v = x[i + b * LANES + l];
+                bm[l] = v > bm[l] ? v : bm[l];
+            }
+        alignas(64) float base[LANES];
+        alignas(64) float acc[LANES];
+        for (int l = 0; l < LANES; l++) base[l] = exp_base(bm[l]);
+        for (int l = 0; l < LANES; l++) acc[l] = s[l] * exp_approx(m[l] - base[l]);
+        for (int b = 0; b < BLOCK; b++)
+            for (int l = 0; l < LANES; l++) acc[l] += exp_approx(x[i + b * LANES + l] - base[l]);
+        for (int l = 0; l < LANES; l++) {
+            s[l] = acc[l];
+            m[l] = bm[l];
+        }
+    }
+    // Tail: fold element by element into lane 0
+    for (; i < n; i++) {
+        const float mn = x[i] > m[0] ? x[i] : m[0];
+        const float base = exp_base(mn);
+        s[0] = s[0] * exp_approx(m[0] - base) + exp_approx(x[i] - base);
+        m[0] = mn;
+    }
+
+    float row_max = m[0];
+    for (int l = 1; l < LANES; l++) row_max = m[l] > row_max ? m[l] : row_max;
+    row_max = exp_base(row_max);
+    float row_sum = 0.0f;
+    for (int l = 0; l < LANES; l++) row_sum += s[l] * exp_approx(m[l] - row_max);
+
+    const float inv = row_sum > 0.0f ? 1.0f / row_sum : 0.0f;
+    for (int j = 0; j < n; j++) y[j] = exp_approx(x[j] - row_max) * inv;
+}
+
+} // namespace softmax_kernel
+
+#endif // SOFTMAX_KERNEL_H
@@ -0,0 +1,277 @@
+// Batched PE ESL Testbench
+// Drives pe_batch_sc next to NUM_PES separate pe_top_sc modules with the same
+// per-PE stimulus and checks every stage register and result port against
+// them, then times the batched model against the 64-module baseline.
+
+#include <systemc.h>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include "pe_batch_sc.h"
+#include "pe_top_sc.h"
+
+const int DW = 32;
+const int VW = 8;
+const int ROWS = 8;
+const int NUM_PES = 64;
+const int W = DW * VW;
+
+typedef pe_batch_sc<DW, VW, ROWS, 8, NUM_PES> batch_t;
+typedef pe_top_sc<DW, VW, ROWS, 8> ref_t;
+
+// Instruction fields: opcode [31:28], sub-op [25:24], type [7:0]
+static uint32_t mac_instr(int op) { return 0x10000000u | ((uint32_t)op << 24); }
+static uint32_t act_instr(int type, int op = 0) { return 0x20000000u | ((uint32_t)op << 24) | (uint32_t)type; }
+static uint32_t norm_instr(int type) { return 0x30000000u | (uint32_t)type; }
+
+static int lane(const sc_bv<W>& v, int i) {
+    return v.range(i * DW + DW - 1, i * DW).to_int();
+}
+
+static uint32_t xorshift(uint32_t& s) {
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    return s;
+}
+
+int sc_main(int argc, char* argv[]) {
+    std::cout << "========================================" << std::endl;
+    std::cout << "Batched PE ESL Model (" << NUM_PES << " PEs)" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    // Separate clocks so each model can be timed on its own
+    sc_signal<bool> clk_batch, clk_ref;
+    sc_signal<bool> rst_n;
+    sc_vector<sc_signal<bool>> valid_in("valid_in", NUM_PES);
+    sc_vector<sc_signal<sc_uint<32>>> instr("instr", NUM_PES);
+    sc_vector<sc_signal<sc_bv<W>>> a("a", NUM_PES), b("b", NUM_PES), w("w", NUM_PES);
+
+    sc_vector<sc_signal<bool>> ready("ready", NUM_PES);
+    sc_vector<sc_signal<bool>> valid_out("valid_out", NUM_PES);
+    sc_vector<sc_signal<sc_bv<W>>> result("result", NUM_PES);
+
+    batch_t dut("pe_batch");
+    dut.clk(clk_batch); dut.rst_n(rst_n);
+    dut.valid_in(valid_in); dut.ready_out(ready); dut.instruction(instr);
+    dut.data_a_i(a); dut.data_b_i(b); dut.weight_i(w);
+    dut.result_o(result); dut.valid_out(valid_out);
+
+    // Baseline: one pe_top_sc per PE on the same inputs
+    sc_vector<sc_signal<bool>> ref_ready("ref_ready", NUM_PES);
+    sc_vector<sc_signal<bool>> ref_valid_out("ref_valid_out", NUM_PES);
+    sc_vector<sc_signal<sc_bv<W>>> ref_result("ref_result", NUM_PES);
+    std::vector<ref_t*> refs;
+    for (int pe = 0; pe < NUM_PES; pe++) {
+        ref_t* r = new ref_t(("ref_pe_" + std::to_string(pe)).c_str());
+        r->clk(clk_ref); r->rst_n(rst_n);
+        r->valid_in(valid_in[pe]); r->ready_out(ref_ready[pe]); r->instruction(instr[pe]);
+        r->data_a_i(a[pe]); r->data_b_i(b[pe]); r->weight_i(w[pe]);
+        r->result_o(ref_result[pe]); r->valid_out(ref_valid_out[pe]);
+        refs.push_back(r);
+    }
+
+    // Inputs settle (and pe_top_sc decodes them) while the clock is low
+    auto cycle = [&](bool run_batch, bool run_ref) {
+        clk_batch.write(false);
+        clk_ref.write(false);
+        sc_start(5, SC_NS);
+        if (run_batch) clk_batch.write(true);
+        if (run_ref) clk_ref.write(true);
+        sc_start(5, SC_NS);
+    };
+
+    // Every stage register and every valid result must match the baseline
+    int mismatches = 0;
+    auto compare = [&](const char* where) {
+        for (int pe = 0; pe < NUM_PES; pe++) {
+            const ref_t& r = *refs[pe];
+            const sc_bv<W> mac = r.mac_result_sig.read();
+            const sc_bv<W> act = r.activation_result_sig.read();
+            const sc_bv<W> norm = r.norm_result_sig.read();
+            for (int row = 0; row < ROWS; row++) {
+                const int got[3] = { dut.engine().mac_result(pe, row), dut.engine().act_result(pe, row),
+                                     dut.engine().norm_result(pe, row) };
+                const int exp[3] = { lane(mac, row), lane(act, row), lane(norm, row) };
+                static const char* stage[3] = { "mac", "act", "norm" };
+                for (int s = 0; s < 3; s++) {
+                    if (got[s] == exp[s]) continue;
+                    if (mismatches < 5)
+                        std::cout << "  " << where << ": PE " << pe << " " << stage[s] << " row " << row
+                                  << ": got " << got[s] << ", expected " << exp[s] << std::endl;
+                    mismatches++;
+                }
+            }
+            if (valid_out[pe].read() != ref_valid_out[pe].read() ||
+                (valid_out[pe].read() && result[pe].read() != ref_result[pe].read())) {
+                if (mismatches < 5)
+                    std::cout << "  " << where << ": PE " << pe << " result port differs" << std::endl;
+                mismatches++;
+            }
+        }
+    };
+
+    auto drive = [&](int pe, uint32_t ins, bool valid, const int* bv, const int* wv) {
+        sc_bv<W> da, db, dw;
+        for (int i = 0; i < VW; i++) {
+            da.range(i * DW + DW - 1, i * DW) = 1000 * pe + i;
+            db.range(i * DW + DW - 1, i * DW) = bv[i];
+            dw.range(i * DW + DW - 1, i * DW) = wv[i];
+        }
+        instr[pe].write(ins); valid_in[pe].write(valid);
+        a[pe].write(da); b[pe].write(db); w[pe].write(dw);
+    };
+
+    // Same instruction on every PE, b = k * (pe + 1) (negative for odd PEs), w = 1
+    auto issue_all = [&](uint32_t ins, int k) {
+        for (int pe = 0; pe < NUM_PES; pe++) {
+            int bv[VW], wv[VW];
+            for (int i = 0; i < VW; i++) {
+                bv[i] = (pe & 1 ? -k : k) * (pe + 1) + i;
+                wv[i] = 1;
+            }
+            drive(pe, ins, true, bv, wv);
+        }
+        cycle(true, true);
+        compare("issue");
+    };
+    auto idle = [&]() {
+        for (int pe = 0; pe < NUM_PES; pe++) valid_in[pe].write(false);
+        cycle(true, true);
+        compare("idle");
+    };
+    auto passed = [&](const char* what, int before) {
+        if (mismatches == before) {
+            std::cout << what << " matches pe_top_sc" << std::endl;
+            return 1;
+        }
+        std::cout << what << ": " << (mismatches - before) << " mismatches" << std::endl;
+        return 0;
+    };
+
+    rst_n.write(false);
+    cycle(true, true); cycle(true, true);
+    rst_n.write(true);
+    cycle(true, true);
+
+    int t = 0, pass = 0, before;
+
+    // ========================================
+    // Test 0: MAC load / accumulate / drain
+    // ========================================
+    std::cout << "\n--- Test " << t++ << ": MAC load/accumulate/drain ---" << std::endl;
+    before = mismatches;
+    issue_all(mac_instr(0), 3); idle();
+    issue_all(mac_instr(1), 0);
+    for (int k = 1; k <= 4; k++) issue_all(mac_instr(2), k);
+    issue_all(mac_instr(3), 0); idle();
+    pass += passed("MAC", before);
+
+    // ========================================
+    // Test 1: Activation functions, one per PE
+    // ========================================
+    std::cout << "\n--- Test " << t++ << ": Activation ---" << std::endl;
+    before = mismatches;
+    issue_all(mac_instr(0), 2);
+    for (int pe = 0; pe < NUM_PES; pe++) instr[pe].write(act_instr(1 + pe % 4));
+    cycle(true, true); compare("act");
+    idle();
+    pass += passed("Activation", before);
+
+    // ========================================
+    // Test 2: Normalization, LayerNorm on even PEs and RMSNorm on odd
+    // ========================================
+    std::cout << "\n--- Test " << t++ << ": Normalization ---" << std::endl;
+    before = mismatches;
+    issue_all(mac_instr(0), 5);
+    for (int pe = 0; pe < NUM_PES; pe++) instr[pe].write(act_instr(1));
+    cycle(true, true); compare("act");
+    for (int pe = 0; pe < NUM_PES; pe++) instr[pe].write(norm_instr(pe & 1));
+    cycle(true, true); compare("norm");
+    idle();
+    pass += passed("Normalization", before);
+
+    // ========================================
+    // Test 3: Softmax over a row of MAC results
+    // ========================================
+    std::cout << "\n--- Test " << t++ << ": Softmax ---" << std::endl;
+    before = mismatches;
+    // Q16.16 logits around 1.0
+    issue_all(mac_instr(0), 1 << 11);
+    for (int pe = 0; pe < NUM_PES; pe++) instr[pe].write(act_instr(5, 0));
+    cycle(true, true); compare("softmax load");
+    for (int pe = 0; pe < NUM_PES; pe++) instr[pe].write(act_instr(5, 3));
+    cycle(true, true); compare("softmax drain");
+    idle();
+    pass += passed("Softmax", before);
+
+    // ========================================
+    // Test 4: Random per-PE instruction mix
+    // ========================================
+    std::cout << "\n--- Test " << t++ << ": Random instruction mix ---" << std::endl;
+    before = mismatches;
+    {
+        static const uint32_t mix[] = {
+            mac_instr(0), mac_instr(1), mac_instr(2), mac_instr(2), mac_instr(3),
+            act_instr(1), act_instr(2), act_instr(3), act_instr(4),
+            norm_instr(0), norm_instr(1), 0x00000000u
+        };
+        uint32_t seed = 12345;
+        for (int c = 0; c < 500; c++) {
+            for (int pe = 0; pe < NUM_PES; pe++) {
+                int bv[VW], wv[VW];
+                for (int i = 0; i < VW; i++) {
+                    bv[i] = (int)(xorshift(seed) % 2001) - 1000;
+                    wv[i] = (int)(xorshift(seed) % 65) - 32;
+                }
+                const uint32_t ins = mix[xorshift(seed) % (sizeof(mix) / sizeof(mix[0]))];
+                drive(pe, ins, xorshift(seed) % 8 != 0, bv, wv);
+            }
+            cycle(true, true);
+            compare("random");
+        }
+    }
+    pass += passed("Random mix", before);
+
+    // ========================================
+    // Throughput against the 64-module baseline (informational only;
+    // wall-clock timing depends on the host and does not count)
+    // ========================================
+    std::cout << "\n--- Throughput (not counted) ---" << std::endl;
+    const int CYCLES = 2000;
+    for (int pe = 0; pe < NUM_PES; pe++) {
+        instr[pe].write(mac_instr(2)); valid_in[pe].write(true);
+    }
+    auto time_cycles = [&](bool run_batch, bool run_ref) {
+        auto start = std::chrono::steady_clock::now();
+        for (int c = 0; c < CYCLES; c++) cycle(run_batch, run_ref);
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+    const double batch_secs = time_cycles(true, false);
+    const double ref_secs = time_cycles(false, true);
+    std::cout << "pe_batch_sc:       " << (double)CYCLES * NUM_PES / batch_secs << " PE-cycles/s" << std::endl;
+    std::cout << NUM_PES << " x pe_top_sc:    " << (double)CYCLES * NUM_PES / ref_secs << " PE-cycles/s" << std::endl;
+    std::cout << "Speedup:           " << ref_secs / batch_secs << "x" << std::endl;
+
+    // ========================================
+    // Results
+    // ========================================
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "REGRESSION RESULTS (Batched PE)" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "Total Tests:  " << t << std::endl;
+    std::cout << "Passed:       " << pass << std::endl;
+    std::cout << "Failed:       " << (t - pass) << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    for (ref_t* r : refs) delete r;
+
+    if (pass == t) {
+        std::cout << "SUCCESS: All batched PE tests passed!" << std::endl;
+        return 0;
+    }
+    std::cout << "FAILURE: Some tests failed!" << std::endl;
+    return 1;
+}
@@ -0,0 +1,348 @@
+// PE Command Processor ESL Testbench
+// Host issue overhead vs. queued loops and binary microprograms
+//
+// Every scenario runs a tiled MAC kernel (CLEAR, K x ACC, DRAIN, ReLU per
+// tile) through its own pe_cmd_proc_sc + PE pair. The host inserts `gap` idle
+// cycles between instruction words to model driver issue cost; operands
+// stream from a DMA model. A checker verifies every DRAIN result and the
+// table shows issue-slot utilization and where the idle slots went.
+
+#include <systemc.h>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include "pe_cmd_proc_sc.h"
+#include "pe_batch_sc.h"
+
+const int DW = 32;
+const int VW = 8;
+const int W = DW * VW;
+
+typedef pe_cmd_proc_sc<DW, VW> cmd_t;
+typedef pe_batch_sc<DW, VW, 8, 8, 1> pe_t;
+typedef sc_bv<W> vec_t;
+
+const uint32_t MAC_CLEAR = 0x11000000;
+const uint32_t MAC_ACC = 0x12000000;
+const uint32_t MAC_DRAIN = 0x13000000;
+const uint32_t ACT_RELU = 0x20000001;
+
+struct scenario {
+    std::string name;
+    std::vector<uint32_t> program;
+    int gap;                    // Host idle cycles between instruction words
+    int dma_gap;                // DMA idle cycles between operand beats
+    int depth;                  // Instruction FIFO depth
+};
+
+// ============================================
+// Host: streams instruction words, DMA: streams operands
+// ============================================
+SC_MODULE(cmd_host) {
+    sc_in<bool> clk;
+    sc_out<bool> valid, data_valid;
+    sc_in<bool> ready, data_ready;
+    sc_out<sc_uint<32>> instr;
+    sc_out<vec_t> a, b, w;
+
+    std::vector<uint32_t> program;
+    int gap, dma_gap;
+    size_t pos;
+    int wait_cycles, dma_wait;
+    uint32_t beat;
+    bool ready_seen, data_ready_seen;   // Ready values the next rising edge samples
+
+    SC_CTOR(cmd_host)
+        : gap(0), dma_gap(0), pos(0), wait_cycles(0), dma_wait(0), beat(0)
+        , ready_seen(false), data_ready_seen(false) {
+        SC_METHOD(drive);
+        sensitive << clk.neg();
+        dont_initialize();
+    }
+
+    // Operand beat n: every lane of b = n + 1, weights = 1
+    static vec_t beat_b(uint32_t n) {
+        vec_t v;
+        for (int i = 0; i < VW; i++) v.range(i * DW + DW - 1, i * DW) = n + 1;
+        return v;
+    }
+
+    void drive() {
+        // Instruction accepted on the last rising edge?
+        if (valid.read() && ready_seen) {
+            pos++;
+            wait_cycles = gap;
+        } else if (wait_cycles > 0) {
+            wait_cycles--;
+        }
+        const bool send = pos < program.size() && wait_cycles == 0;
+        valid.write(send);
+        if (send) instr.write(program[pos]);
+
+        if (data_valid.read() && data_ready_seen) {
+            beat++;
+            dma_wait = dma_gap;
+        } else if (dma_wait > 0) {
+            dma_wait--;
+        }
+        data_valid.write(dma_wait == 0);
+        a.write(0);
+        b.write(beat_b(beat));
+        vec_t ones;
+        for (int i = 0; i < VW; i++) ones.range(i * DW + DW - 1, i * DW) = 1;
+        w.write(ones);
+
+        ready_seen = ready.read();
+        data_ready_seen = data_ready.read();
+    }
+};
+
+// ============================================
+// Checker: every DRAIN must hold the sum of its tile's ACC beats
+// ============================================
+SC_MODULE(drain_checker) {
+    sc_in<bool> clk;
+    sc_in<bool> pe_valid;
+    sc_in<sc_uint<32>> pe_instr;
+
+    const pe_t* pe;
+    int k;
+    int tiles_checked, errors;
+    bool pending;
+
+    SC_CTOR(drain_checker) : pe(nullptr), k(0), tiles_checked(0), errors(0), pending(false) {
+        SC_METHOD(check);
+        sensitive << clk.neg();
+        dont_initialize();
+    }
+
+    // CLEAR and DRAIN take no beat, so tile t's ACCs use beats t*K .. t*K+K-1,
+    // and beat n carries b = n + 1
+    int expected(int t) const {
+        const int base = t * k;
+        return 8 * (k * base + k * (k + 1) / 2);
+    }
+
+    void check() {
+        if (pending) {
+            const int e = expected(tiles_checked);
+            for (int row = 0; row < 8; row++) {
+                if (pe->engine().mac_result(0, row) != e) {
+                    if (errors++ < 4) {
+                        std::cout << "  tile " << tiles_checked << " row " << row << ": got "
+                                  << pe->engine().mac_result(0, row) << ", expected " << e << std::endl;
+                    }
+                    break;
+                }
+            }
+            tiles_checked++;
+        }
+        pending = pe_valid.read() && pe_instr.read() == MAC_DRAIN;
+    }
+};
+
+// ============================================
+// One command processor + PE + host per scenario
+// ============================================
+struct cmd_system {
+    sc_signal<bool> valid, ready, data_valid, data_ready, done;
+    sc_signal<sc_uint<32>> instr;
+    sc_signal<vec_t> a, b, w;
+    sc_signal<bool> pe_valid, pe_ready;
+    sc_signal<sc_uint<32>> pe_instr;
+    sc_signal<vec_t> pe_a, pe_b, pe_w;
+    sc_vector<sc_signal<bool>> pe_valid_out;
+    sc_vector<sc_signal<vec_t>> pe_result;
+
+    cmd_t* cmd;
+    pe_t* pe;
+    cmd_host* host;
+    drain_checker* checker;
+    uint64_t halt_cycle;
+
+    cmd_system(const scenario& s, int k, sc_clock& clk, sc_signal<bool>& rst_n)
+        : pe_valid_out(sc_gen_unique_name("pe_valid_out"), 1)
+        , pe_result(sc_gen_unique_name("pe_result"), 1)
+        , halt_cycle(0) {
+        pe_cmd_config cfg;
+        cfg.instr_depth = s.depth;
+        cmd = new cmd_t(sc_gen_unique_name("cmd"), cfg);
+        cmd->clk(clk); cmd->rst_n(rst_n);
+        cmd->valid_in(valid); cmd->ready_out(ready); cmd->instruction(instr);
+        cmd->data_valid_in(data_valid); cmd->data_ready_out(data_ready);
+        cmd->data_a_i(a); cmd->data_b_i(b); cmd->weight_i(w);
+        cmd->pe_valid(pe_valid); cmd->pe_ready(pe_ready); cmd->pe_instruction(pe_instr);
+        cmd->pe_data_a(pe_a); cmd->pe_data_b(pe_b); cmd->pe_weight(pe_w);
+        cmd->done(done);
+
+        pe = new pe_t(sc_gen_unique_name("pe"));
+        pe->clk(clk); pe->rst_n(rst_n);
+        pe->valid_in[0](pe_valid); pe->ready_out[0](pe_ready); pe->instruction[0](pe_instr);
+        pe->data_a_i[0](pe_a); pe->data_b_i[0](pe_b); pe->weight_i[0](pe_w);
+        pe->result_o(pe_result); pe->valid_out(pe_valid_out);
+
+        host = new cmd_host(sc_gen_unique_name("host"));
+        host->clk(clk);
+        host->valid(valid); host->ready(ready); host->instr(instr);
+        host->data_valid(data_valid); host->data_ready(data_ready);
+        host->a(a); host->b(b); host->w(w);
+        host->program = s.program;
+        host->gap = s.gap;
+        host->dma_gap = s.dma_gap;
+
+        checker = new drain_checker(sc_gen_unique_name("checker"));
+        checker->clk(clk); checker->pe_valid(pe_valid); checker->pe_instr(pe_instr);
+        checker->pe = pe;
+        checker->k = k;
+    }
+};
+
+int sc_main(int argc, char* argv[]) {
+    int tiles = 16, k = 16, gap = 3, depth = 8;
+    std::string prog_path = "pe_tile_kernel.pemp";
+    for (int i = 1; i < argc; i++) {
+        const char* eq = std::strchr(argv[i], '=');
+        if (!eq) continue;
+        std::string key(argv[i], eq - argv[i]);
+        if (key == "prog") { prog_path = eq + 1; continue; }
+        int val = std::atoi(eq + 1);
+        if (key == "tiles") tiles = val;
+        else if (key == "k") k = val;
+        else if (key == "gap") gap = val;
+        else if (key == "depth") depth = val;
+    }
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "PE Command Processor (ESL)" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << tiles << " tiles x (CLEAR, " << k << " x ACC, DRAIN, ReLU), host gap "
+              << gap << " cycles" << std::endl;
+
+    // Unrolled stream: every instruction issued by the host
+    std::vector<uint32_t> unrolled;
+    for (int t = 0; t < tiles; t++) {
+        unrolled.push_back(MAC_CLEAR);
+        for (int i = 0; i < k; i++) unrolled.push_back(MAC_ACC);
+        unrolled.push_back(MAC_DRAIN);
+        unrolled.push_back(ACT_RELU);
+    }
+    unrolled.push_back(pe_ucode::halt());
+
+    // Same kernel as a looped microprogram, round-tripped through the binary loader
+    std::vector<uint32_t> looped = {
+        pe_ucode::loop(5, tiles),
+        MAC_CLEAR, pe_ucode::repeat(k), MAC_ACC, MAC_DRAIN, ACT_RELU,
+        pe_ucode::halt()
+    };
+    std::vector<uint32_t> loaded;
+    std::string err;
+    if (!pe_ucode::save(prog_path, looped) || !pe_ucode::load(prog_path, loaded, &err)) {
+        std::cout << "FAILURE: microprogram loader: " << err << std::endl;
+        return 1;
+    }
+
+    // Operand beats: MAC LOAD/ACC and every passthrough opcode, nothing else
+    {
+        bool ok = true;
+        for (uint32_t op = 0; op < 16; op++) {
+            const bool passthrough = op == 0 || (op >= 4 && op <= 0xB) || op == 0xE;
+            ok = ok && pe_ucode::needs_operand(op << 28) == (passthrough || op == 1);
+        }
+        ok = ok && pe_ucode::needs_operand(MAC_ACC) &&
+             !pe_ucode::needs_operand(MAC_CLEAR) && !pe_ucode::needs_operand(MAC_DRAIN);
+        if (!ok) {
+            std::cout << "FAILURE: needs_operand() does not match pe_top_sc's operand use" << std::endl;
+            return 1;
+        }
+    }
+
+    // A header claiming more words than the file holds is rejected before allocating
+    {
+        const std::string bad_path = prog_path + ".bad";
+        const uint32_t hdr[5] = { pe_ucode::MAGIC, pe_ucode::VERSION, 0x40000000u, 0, pe_ucode::halt() };
+        FILE* f = std::fopen(bad_path.c_str(), "wb");
+        const bool written = f && std::fwrite(hdr, sizeof(hdr), 1, f) == 1;
+        if (f) std::fclose(f);
+        std::vector<uint32_t> bad;
+        if (!written || pe_ucode::load(bad_path, bad, &err) || !bad.empty()) {
+            std::cout << "FAILURE: microprogram loader accepted an oversized word count" << std::endl;
+            return 1;
+        }
+        std::cout << "Oversized microprogram rejected: " << err << std::endl;
+        std::remove(bad_path.c_str());
+    }
+
+    std::vector<scenario> scenarios = {
+        { "unrolled, gap", unrolled, gap, 0, depth },
+        { "unrolled, no gap", unrolled, 0, 0, depth },
+        { "unrolled, slow DMA", unrolled, 0, 1, depth },
+        { "microprogram, gap", loaded, gap, 0, depth },
+        { "microprogram, slow DMA", loaded, gap, 1, depth },
+    };
+
+    sc_clock clk("clk", 10, SC_NS);
+    sc_signal<bool> rst_n;
+    std::vector<cmd_system*> systems;
+    for (size_t i = 0; i < scenarios.size(); i++) {
+        systems.push_back(new cmd_system(scenarios[i], k, clk, rst_n));
+    }
+
+    rst_n.write(false);
+    sc_start(20, SC_NS);
+    rst_n.write(true);
+
+    // Run until every command processor has reached HALT
+    const uint64_t limit = (uint64_t)tiles * (k + 3) * (gap + 2) * 4 + 1000;
+    for (uint64_t cycle = 0; cycle < limit; cycle++) {
+        sc_start(10, SC_NS);
+        bool all_done = true;
+        for (size_t i = 0; i < systems.size(); i++) {
+            if (systems[i]->done.read() && !systems[i]->halt_cycle) systems[i]->halt_cycle = cycle;
+            all_done = all_done && systems[i]->done.read();
+        }
+        if (all_done) break;
+    }
+    sc_start(30, SC_NS);    // Drain the PE pipeline
+
+    // ========================================
+    // Results
+    // ========================================
+    int failed = 0;
+    std::cout << std::left << std::setw(24) << "Scenario" << std::right
+              << std::setw(7) << "Words" << std::setw(8) << "Cycles" << std::setw(8) << "Util"
+              << std::setw(8) << "empty" << std::setw(9) << "operand"
+              << std::setw(9) << "control" << std::setw(8) << "Backpr" << std::setw(8) << "Check" << std::endl;
+    for (size_t i = 0; i < systems.size(); i++) {
+        const cmd_system& s = *systems[i];
+        const cmd_t::queue_t& q = s.cmd->stats();
+        const bool ok = s.done.read() && !q.has_error() && s.checker->errors == 0 &&
+                        s.checker->tiles_checked == tiles;
+        if (!ok) failed++;
+        std::cout << std::left << std::setw(24) << scenarios[i].name << std::right
+                  << std::setw(7) << scenarios[i].program.size() << std::setw(8) << s.halt_cycle
+                  << std::setw(7) << std::fixed << std::setprecision(1) << q.utilization() * 100.0 << "%"
+                  << std::defaultfloat
+                  << std::setw(8) << q.stall_count(cmd_t::queue_t::STALL_EMPTY)
+                  << std::setw(9) << q.stall_count(cmd_t::queue_t::STALL_OPERAND)
+                  << std::setw(9) << q.stall_count(cmd_t::queue_t::STALL_CONTROL)
+                  << std::setw(8) << q.backpressure_cycles()
+                  << std::setw(8) << (ok ? "ok" : "FAIL") << std::endl;
+    }
+
+    std::cout << "\nDetail for the microprogram run:" << std::endl;
+    systems[3]->cmd->stats().report(std::cout);
+
+    std::cout << "\n========================================" << std::endl;
+    if (failed == 0) {
+        std::cout << "SUCCESS: All " << systems.size() << " scenarios produced correct tiles!" << std::endl;
+    } else {
+        std::cout << "FAILURE: " << failed << " scenarios failed!" << std::endl;
+    }
+    std::cout << "========================================" << std::endl;
+
+    return failed ? 1 : 0;
+}
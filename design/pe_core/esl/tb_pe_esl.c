@@ -0,0 +1,227 @@
+/*
+ * libpe_esl C API Testbench
+ * Drives the embedded PE model through the C ABI only
+ *
+ * Batches of tiled K-reductions (LOOP over LOAD, REPEAT ACC, DRAIN) run
+ * asynchronously with a completion callback and are checked against a host
+ * reference. The weight tile is shared by every beat (weight_beats = 1), so
+ * it is never replicated. Error paths (output overflow, operand underrun,
+ * malformed program), a callback that frees its batch and cancellation on
+ * destroy are checked too.
+ */
+
+#define _POSIX_C_SOURCE 199309L     /* nanosleep */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "pe_esl.h"
+
+#define NUM_PES 16
+#define TILES 64
+#define K 16
+#define BATCHES 8
+
+static int callbacks = 0;
+static int failed = 0;
+
+static void on_done(pe_esl_batch* batch, void* user) {
+    (void)user;
+    (void)batch;
+    callbacks++;        /* Callbacks run one at a time on the model thread */
+}
+
+/* Frees its batch; naps first so the pe_esl_wait() below is already blocked */
+static void free_batch(pe_esl_batch* batch, void* user) {
+    const struct timespec nap = { 0, 20000000 };
+    (void)user;
+    nanosleep(&nap, NULL);
+    free(batch);
+    callbacks++;
+}
+
+static void check(int cond, const char* what) {
+    printf("  %-44s %s\n", what, cond ? "ok" : "FAIL");
+    if (!cond) failed++;
+}
+
+/* LOOP { LOAD, REPEAT(K-1) ACC, DRAIN } x TILES, then HALT */
+static const uint32_t program[] = {
+    0xC0040000u | TILES,
+    0x10000000u,
+    0xD0000000u | (K - 1), 0x12000000u,
+    0x13000000u,
+    0xF0000000u
+};
+
+int main(void) {
+    const int rows = pe_esl_mac_rows();
+    const int cols = pe_esl_mac_cols();
+    const size_t beats = (size_t)TILES * K;             /* LOAD and ACC take a beat, DRAIN none */
+    const size_t beat_lanes = (size_t)rows * NUM_PES;
+    const size_t out_beats = (size_t)TILES * 2;         /* LOAD and DRAIN results */
+    pe_esl_config cfg;
+    pe_esl_model* model = NULL;
+    pe_esl_batch batch[BATCHES];
+    pe_esl_counters ctr;
+    int32_t* data_b;
+    int32_t* weight;
+    int32_t* out;
+    int64_t wsum[NUM_PES];
+    size_t i;
+    int n, t, r, pe, k, mismatches = 0;
+    clock_t t0;
+    double secs;
+
+    printf("========================================\n");
+    printf("libpe_esl C API (API version %d)\n", pe_esl_api_version());
+    printf("========================================\n");
+
+    pe_esl_config_init(&cfg);
+    cfg.num_pes = NUM_PES;
+    if (pe_esl_create(&cfg, &model) != PE_ESL_OK) {
+        printf("FAILURE: pe_esl_create failed\n");
+        return 1;
+    }
+
+    /* Caller-owned tensors, shared by all batches */
+    data_b = (int32_t*)malloc(beats * beat_lanes * sizeof(int32_t));
+    weight = (int32_t*)malloc((size_t)cols * NUM_PES * sizeof(int32_t));
+    out = (int32_t*)malloc((size_t)BATCHES * out_beats * beat_lanes * sizeof(int32_t));
+    for (i = 0; i < beats * beat_lanes; i++) data_b[i] = (int32_t)((i * 2654435761u) % 61) - 30;
+    for (pe = 0; pe < NUM_PES; pe++) {
+        wsum[pe] = 0;
+        for (k = 0; k < cols; k++) {
+            weight[k * NUM_PES + pe] = (pe + k) % 5 - 2;
+            wsum[pe] += weight[k * NUM_PES + pe];
+        }
+    }
+
+    printf("\n--- Async batches: %d x %d tiles, K=%d, %d PEs ---\n", BATCHES, TILES, K, NUM_PES);
+    t0 = clock();
+    for (n = 0; n < BATCHES; n++) {
+        memset(&batch[n], 0, sizeof(batch[n]));
+        batch[n].struct_size = sizeof(batch[n]);
+        batch[n].program = program;
+        batch[n].program_words = sizeof(program) / sizeof(program[0]);
+        batch[n].data_b = data_b;
+        batch[n].data_beats = beats;
+        batch[n].weight = weight;
+        batch[n].weight_beats = 1;
+        batch[n].out = out + (size_t)n * out_beats * beat_lanes;
+        batch[n].out_capacity = out_beats;
+        batch[n].on_done = on_done;
+        pe_esl_submit(model, &batch[n]);
+    }
+    check(pe_esl_wait(model, NULL, -1) == PE_ESL_OK, "wait for all batches");
+    secs = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    check(callbacks == BATCHES, "one callback per batch");
+
+    for (n = 0; n < BATCHES; n++) {
+        const int32_t* o = batch[n].out;
+        if (batch[n].status != PE_ESL_OK || batch[n].out_beats != out_beats) mismatches++;
+        for (t = 0; t < TILES; t++) {
+            for (r = 0; r < rows; r++) {
+                for (pe = 0; pe < NUM_PES; pe++) {
+                    int64_t acc = 0;
+                    for (k = 0; k < K; k++)
+                        acc += data_b[(((size_t)t * K + k) * rows + r) * NUM_PES + pe] * wsum[pe];
+                    if (o[((size_t)(2 * t + 1) * rows + r) * NUM_PES + pe] != (int32_t)acc) mismatches++;
+                }
+            }
+        }
+    }
+    check(mismatches == 0, "every DRAIN matches the host reference");
+    printf("  %llu cycles per batch (%d issue slots needed)\n",
+           (unsigned long long)batch[0].cycles, TILES * (K + 2));
+
+    printf("\n--- Error paths ---\n");
+    {
+        pe_esl_batch e;
+        const uint32_t bad_loop[] = { 0xC0000004u, 0x10000000u };
+
+        e = batch[0];
+        e.on_done = NULL;
+        e.out_capacity = 3;
+        pe_esl_submit(model, &e);
+        check(pe_esl_wait(model, &e, -1) == PE_ESL_ERR_OVERFLOW && e.out_beats == 3, "output overflow");
+
+        e = batch[0];
+        e.on_done = NULL;
+        e.data_beats = beats - 1;
+        pe_esl_submit(model, &e);
+        check(pe_esl_wait(model, &e, -1) == PE_ESL_ERR_UNDERRUN, "operand underrun");
+
+        e = batch[0];
+        e.on_done = NULL;
+        e.program = bad_loop;
+        e.program_words = 2;
+        pe_esl_submit(model, &e);
+        check(pe_esl_wait(model, &e, -1) == PE_ESL_ERR_PROGRAM, "empty loop rejected");
+        printf("    error: %s\n", e.error);
+
+        check(pe_esl_submit(model, NULL) == PE_ESL_ERR_ARG, "null batch rejected");
+        e = batch[0];
+        e.struct_size = 0;
+        check(pe_esl_submit(model, &e) == PE_ESL_ERR_ARG, "batch without struct_size rejected");
+        {
+            /* A caller built against a shorter config: the rest defaults */
+            pe_esl_config old_cfg;
+            pe_esl_model* old_model = NULL;
+            memset(&old_cfg, 0xFF, sizeof(old_cfg));
+            old_cfg.struct_size = (uint32_t)(offsetof(pe_esl_config, num_pes) + sizeof(old_cfg.num_pes));
+            old_cfg.num_pes = 4;
+            check(pe_esl_create(&old_cfg, &old_model) == PE_ESL_OK, "shorter config struct accepted");
+            pe_esl_destroy(old_model);
+        }
+        check(strcmp(pe_esl_status_string(PE_ESL_ERR_NOMEM), "unknown status") != 0, "out-of-memory status named");
+        check(pe_esl_reset(model) == PE_ESL_OK && pe_esl_wait(model, NULL, 1000) == PE_ESL_OK,
+              "reset between batches");
+    }
+
+    /* The waiter gets the status from the model, not the freed batch */
+    printf("\n--- Callback frees the batch ---\n");
+    {
+        pe_esl_batch* h = (pe_esl_batch*)malloc(sizeof(*h));
+        *h = batch[0];
+        h->on_done = free_batch;
+        callbacks = 0;
+        pe_esl_submit(model, h);
+        check(pe_esl_wait(model, h, -1) == PE_ESL_OK && callbacks == 1, "wait on a batch its callback freed");
+    }
+
+    pe_esl_get_counters(model, &ctr, sizeof(ctr));
+    printf("\n--- Counters ---\n");
+    printf("  cycles=%llu issued=%llu mac=%llu stalls: empty=%llu operand=%llu control=%llu\n",
+           (unsigned long long)ctr.cycles, (unsigned long long)ctr.issued,
+           (unsigned long long)ctr.mac_beats, (unsigned long long)ctr.stall_empty,
+           (unsigned long long)ctr.stall_operand, (unsigned long long)ctr.stall_control);
+    printf("  batches ok=%llu failed=%llu, %.2f Mcycles/s (%d PEs)\n",
+           (unsigned long long)ctr.batches_ok, (unsigned long long)ctr.batches_failed,
+           ctr.busy_ns ? (double)ctr.cycles * 1e3 / (double)ctr.busy_ns : 0.0, NUM_PES);
+    printf("  async batches took %.3f s of CPU time\n", secs);
+    check(ctr.batches_ok == BATCHES + 1 && ctr.batches_failed == 3, "batch counters");
+
+    /* Destroy with work still queued: remaining batches are cancelled */
+    printf("\n--- Destroy with queued batches ---\n");
+    callbacks = 0;
+    for (n = 0; n < BATCHES; n++) pe_esl_submit(model, &batch[n]);
+    pe_esl_destroy(model);
+    check(callbacks == BATCHES, "every queued batch completed or cancelled");
+    for (n = 0, k = 0; n < BATCHES; n++) k += batch[n].status == PE_ESL_ERR_CANCELLED;
+    printf("  %d of %d cancelled\n", k, BATCHES);
+
+    free(data_b);
+    free(weight);
+    free(out);
+
+    printf("\n========================================\n");
+    if (failed == 0) {
+        printf("SUCCESS: All C API checks passed!\n");
+    } else {
+        printf("FAILURE: %d C API checks failed!\n", failed);
+    }
+    printf("========================================\n");
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,171 @@
+// Online Softmax Host Kernel Testbench
+// Accuracy against a double-precision reference and throughput vs. three-pass
+//
+// Rows are attention-like scores with a wide dynamic range, so an
+// implementation without max subtraction would overflow. Row lengths go
+// from a single VECTOR_WIDTH beat to 32K elements. Masked rows (-inf
+// scores) check that empty lanes never produce NaN. No SystemC dependency.
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include "softmax_kernel.h"
+
+using namespace softmax_kernel;
+
+struct error_stats {
+    double max_abs;
+    double max_rel;
+    double sum_err;     // |sum(y) - 1|
+};
+
+static error_stats compare(const std::vector<float>& y, const std::vector<float>& ref) {
+    error_stats e = { 0.0, 0.0, 0.0 };
+    double sum = 0.0;
+    for (size_t i = 0; i < y.size(); i++) {
+        const double d = std::fabs((double)y[i] - ref[i]);
+        e.max_abs = d > e.max_abs ? d : e.max_abs;
+        if (ref[i] > 1e-30f) {
+            const double r = d / ref[i];
+            e.max_rel = r > e.max_rel ? r : e.max_rel;
+        }
+        sum += y[i];
+    }
+    e.sum_err = std::fabs(sum - 1.0);
+    return e;
+}
+
+// Scores in [-40, 40] from a fixed LCG
+static void fill_scores(std::vector<float>& x, uint32_t seed) {
+    for (size_t i = 0; i < x.size(); i++) {
+        seed = seed * 1664525u + 1013904223u;
+        x[i] = ((float)(seed >> 8) / (float)(1u << 24)) * 80.0f - 40.0f;
+    }
+}
+
+static bool all_zero(const std::vector<float>& y) {
+    for (float v : y)
+        if (v != 0.0f) return false;
+    return true;
+}
+
+static void report(const char* what, bool ok, int& failed) {
+    std::cout << "  " << std::left << std::setw(52) << what << (ok ? "ok" : "FAIL") << std::right << std::endl;
+    if (!ok) failed++;
+}
+
+template <typename F>
+static double elems_per_sec(F kernel, const std::vector<float>& x, std::vector<float>& y,
+                            int rows, int len) {
+    // Warm up, then time enough repetitions for a stable figure
+    for (int r = 0; r < rows; r++) kernel(&x[(size_t)r * len], &y[(size_t)r * len], len);
+    int reps = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    double secs = 0.0;
+    do {
+        for (int r = 0; r < rows; r++) kernel(&x[(size_t)r * len], &y[(size_t)r * len], len);
+        reps++;
+        secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    } while (secs < 0.2);
+    return (double)reps * rows * len / secs;
+}
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "Online Softmax Host Kernel" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    const int lengths[] = { 8, 100, 1024, 4096, 32768 };
+    const double tolerance = 1e-5;      // Max relative error for passing
+    int failed = 0;
+
+    std::cout << std::left << std::setw(8) << "Length" << std::right
+              << std::setw(12) << "max abs" << std::setw(12) << "max rel"
+              << std::setw(12) << "|sum-1|" << std::setw(14) << "3-pass Me/s"
+              << std::setw(14) << "online Me/s" << std::setw(9) << "Speedup"
+              << std::setw(8) << "Check" << std::endl;
+
+    for (int len : lengths) {
+        const int rows = len >= 4096 ? 16 : 4096 / len + 1;
+        std::vector<float> x((size_t)rows * len), y(x.size()), ref(len);
+        fill_scores(x, 12345u + len);
+
+        // Accuracy on the first row
+        std::vector<float> row(x.begin(), x.begin() + len), out(len);
+        softmax_reference(row.data(), ref.data(), len);
+        softmax_online(row.data(), out.data(), len);
+        const error_stats e = compare(out, ref);
+        const bool ok = e.max_rel < tolerance && e.sum_err < tolerance;
+        if (!ok) failed++;
+
+        const double naive = elems_per_sec(softmax_three_pass, x, y, rows, len);
+        const double online = elems_per_sec(softmax_online, x, y, rows, len);
+
+        std::cout << std::left << std::setw(8) << len << std::right << std::scientific
+                  << std::setprecision(2) << std::setw(12) << e.max_abs << std::setw(12) << e.max_rel
+                  << std::setw(12) << e.sum_err << std::fixed << std::setprecision(0)
+                  << std::setw(14) << naive / 1e6 << std::setw(14) << online / 1e6
+                  << std::setprecision(2) << std::setw(8) << online / naive << "x"
+                  << std::setw(8) << (ok ? "ok" : "FAIL") << std::endl;
+    }
+
+    // ========================================
+    // Masked rows (attention masks, padding)
+    // ========================================
+    std::cout << "\nMasked rows:" << std::endl;
+    {
+        const float ninf = -std::numeric_limits<float>::infinity();
+        const int len = 256;    // Two full LANES x BLOCK chunks
+
+        // 8 live scores, then a -inf tail: lanes 8..15 stay empty throughout
+        std::vector<float> x(len, ninf), y(len), ref(len);
+        std::vector<float> live(8);
+        fill_scores(live, 777u);
+        for (int i = 0; i < 8; i++) x[i] = live[i];
+        softmax_reference(x.data(), ref.data(), len);
+        softmax_online(x.data(), y.data(), len);
+        const error_stats e = compare(y, ref);
+        report("8 live + 248 masked: matches reference", e.max_rel < tolerance && e.sum_err < tolerance, failed);
+        report("8 live + 248 masked: masked outputs are 0",
+               all_zero(std::vector<float>(y.begin() + 8, y.end())), failed);
+
+        // Every score masked: no NaN, all zeros
+        std::vector<float> masked(len, ninf);
+        softmax_online(masked.data(), y.data(), len);
+        report("all 256 masked: online output is all 0", all_zero(y), failed);
+        std::vector<float> short_y(100);
+        softmax_three_pass(masked.data(), short_y.data(), 100);
+        report("all 100 masked: three-pass output is all 0", all_zero(short_y), failed);
+        softmax_reference(masked.data(), ref.data(), len);
+        report("all 256 masked: reference output is all 0", all_zero(ref), failed);
+
+        // Lane state used by the activation models
+        double m[4], st[4], row_max, row_sum;
+        for (int l = 0; l < 4; l++) lane_reset(m[l], st[l]);
+        for (int l = 0; l < 4; l++) lane_fold(m[l], st[l], -std::numeric_limits<double>::infinity());
+        lane_fold(m[1], st[1], 2.0);
+        lane_fold(m[1], st[1], -std::numeric_limits<double>::infinity());
+        lane_merge(m, st, 4, 1, row_max, row_sum);
+        report("lane fold/merge: masked lanes stay empty, sum = 1",
+               st[0] == 0.0 && st[2] == 0.0 && row_max == 2.0 && row_sum == 1.0, failed);
+        for (int l = 0; l < 4; l++) lane_reset(m[l], st[l]);
+        lane_fold(m[0], st[0], -std::numeric_limits<double>::infinity());
+        lane_merge(m, st, 4, 1, row_max, row_sum);
+        report("lane fold/merge: fully masked row outputs 0",
+               row_sum == 0.0 && lane_prob(1.0, row_max, row_sum) == 0.0, failed);
+    }
+
+    std::cout << "\n========================================" << std::endl;
+    if (failed == 0) {
+        std::cout << "SUCCESS: Online softmax matches the reference at every length!" << std::endl;
+    } else {
+        std::cout << "FAILURE: " << failed << " softmax checks failed!" << std::endl;
+    }
+    std::cout << "========================================" << std::endl;
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,228 @@
+// Tensor I/O and Golden Comparator Testbench
+// .npy round trip through mmap, error statistics and comparator throughput
+//
+// Writes tensors with write_npy(), maps them back with mapped_tensor, and
+// injects known errors to check mismatch counts, max errors and first-failure
+// coordinates. Then times the comparator against a straightforward scalar
+// loop on a 16M-element tensor. No SystemC dependency.
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <unistd.h>
+#include "tensor_io.h"
+#include "golden_compare.h"
+
+using namespace tensor_io;
+
+static int failed = 0;
+
+static void check(bool cond, const std::string& what) {
+    std::cout << "  " << std::left << std::setw(52) << what << (cond ? "ok" : "FAIL") << std::right << std::endl;
+    if (!cond) failed++;
+}
+
+// Version 1 .npy with a hand-written shape and a 64-byte float32 payload
+static void write_hostile_npy(const std::string& path, const char* shape) {
+    std::string hdr = std::string("{'descr': '<f4', 'fortran_order': False, 'shape': ") + shape + ", }";
+    while ((10 + hdr.size() + 1) % 64) hdr += ' ';
+    hdr += '\n';
+    const uint8_t pre[10] = { 0x93, 'N', 'U', 'M', 'P', 'Y', 1, 0, (uint8_t)hdr.size(), 0 };
+    const float payload[16] = {};
+    FILE* f = std::fopen(path.c_str(), "wb");
+    std::fwrite(pre, sizeof(pre), 1, f);
+    std::fwrite(hdr.data(), 1, hdr.size(), f);
+    std::fwrite(payload, sizeof(payload), 1, f);
+    std::fclose(f);
+}
+
+static void fill(std::vector<float>& v, uint32_t seed) {
+    for (size_t i = 0; i < v.size(); i++) {
+        seed = seed * 1664525u + 1013904223u;
+        v[i] = ((float)(seed >> 8) / (float)(1u << 24)) * 8.0f - 4.0f;
+    }
+}
+
+// One element at a time with early-out branches, as a testbench would
+// write it inline
+static size_t scalar_mismatches(const float* g, const float* e, size_t n, double atol, double rtol,
+                                double& max_abs) {
+    size_t bad = 0;
+    max_abs = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        if (std::isnan(g[i]) || std::isnan(e[i])) {
+            if (!(std::isnan(g[i]) && std::isnan(e[i]))) bad++;
+            continue;
+        }
+        double d = std::fabs((double)g[i] - e[i]);
+        if (d > max_abs) max_abs = d;
+        if (d > atol + rtol * std::fabs((double)e[i])) bad++;
+    }
+    return bad;
+}
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "Tensor I/O and Golden Comparator" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    const std::string dir = "tensor_io_test";
+    const std::string f32_path = dir + "_f32.npy";
+    const std::string i32_path = dir + "_i32.npy";
+    const std::string raw_path = dir + ".bin";
+
+    // ========================================
+    // .npy round trip
+    // ========================================
+    std::cout << "\n--- .npy round trip ---" << std::endl;
+    const std::vector<size_t> shape = { 3, 5, 67 };
+    std::vector<float> ref(3 * 5 * 67);
+    fill(ref, 7u);
+    std::vector<int32_t> iref(1000);
+    for (size_t i = 0; i < iref.size(); i++) iref[i] = (int32_t)(i * 37) - 18000;
+
+    std::string err;
+    check(write_npy(f32_path, shape, ref.data(), &err), "write float32 .npy");
+    check(write_npy(i32_path, { iref.size() }, iref.data(), &err), "write int32 .npy");
+    {
+        FILE* f = std::fopen(raw_path.c_str(), "wb");
+        std::fwrite(ref.data(), sizeof(float), ref.size(), f);
+        std::fclose(f);
+    }
+
+    mapped_tensor t, ti, tr, bad;
+    check(t.open_npy(f32_path, &err) && t.type_id() == DT_F32 && t.shape() == shape,
+          "map float32: dtype and shape");
+    check(t.data<float>() && std::memcmp(t.data<float>(), ref.data(), t.bytes()) == 0,
+          "payload read in place");
+    check(((uintptr_t)t.raw() % 64) == 0, "payload 64-byte aligned");
+    check(t.data<int32_t>() == nullptr, "typed access checks the dtype");
+    check(ti.open_npy(i32_path, &err) && ti.count() == iref.size() && ti.data<int32_t>()[999] == iref[999],
+          "map int32 1-D");
+    check(tr.open_raw(raw_path, DT_F32, { 15, 67 }, 0, &err) && tr.data<float>()[100] == ref[100],
+          "map raw binary with given shape");
+    check(!bad.open_raw(raw_path, DT_F32, { 16, 67 }, 0, &err), "raw shape larger than file rejected");
+    std::cout << "    (" << err << ")" << std::endl;
+    check(!bad.open_npy(raw_path, &err), "non-.npy file rejected");
+    std::cout << "    (" << err << ")" << std::endl;
+
+    // Hostile shapes: negative dims, and sizes that wrap size_t to something
+    // the 64-byte payload would satisfy
+    const std::string hostile_path = dir + "_hostile.npy";
+    const char* hostile[][2] = {
+        { "(-1,)", "negative dim rejected" },
+        { "(4611686018427387905,)", "(2**62+1,) float32: byte size overflow rejected" },
+        { "(4294967296, 4294967296)", "(2**32, 2**32): element count overflow rejected" },
+        { "(99999999999999999999999,)", "dim beyond 64 bits rejected" },
+    };
+    for (const auto& h : hostile) {
+        write_hostile_npy(hostile_path, h[0]);
+        check(!bad.open_npy(hostile_path, &err) && !bad.is_open(), h[1]);
+        std::cout << "    (" << err << ")" << std::endl;
+    }
+    check(!bad.open_raw(raw_path, DT_F32, { (size_t)1 << 62, 4 }, 0, &err), "raw shape overflow rejected");
+    std::remove(hostile_path.c_str());
+
+    // ========================================
+    // Error statistics
+    // ========================================
+    std::cout << "\n--- Comparator statistics ---" << std::endl;
+    golden::checker gc;
+    golden::tolerance tol;
+    tol.atol = 1e-6;
+    tol.rtol = 1e-5;
+    tol.max_ulp = 4;
+
+    std::vector<float> out(t.data<float>(), t.data<float>() + t.count());
+    gc.add(golden::compare("exact", out.data(), t, tol));
+    check(gc.all_passed(), "identical tensor passes");
+
+    // 3 ULP off everywhere: within max_ulp
+    std::vector<float> near = out;
+    for (float& v : near) {
+        v = std::nextafter(v, 100.0f);
+        v = std::nextafter(v, 100.0f);
+        v = std::nextafter(v, 100.0f);
+    }
+    golden::tolerance ulp_only;
+    ulp_only.max_ulp = 4;
+    golden::result rn = golden::compare("3ulp", near.data(), t, ulp_only);
+    gc.add(rn);
+    check(rn.passed() && rn.max_ulp == 3, "3 ULP error passes max_ulp=4, reports 3");
+
+    // Injected failures; the first is at [1, 2, 40]
+    std::vector<float> broken = out;
+    const size_t first = (1 * 5 + 2) * 67 + 40;
+    broken[first] += 0.5f;
+    broken[first + 300] = -broken[first + 300];
+    broken[900] = std::numeric_limits<float>::quiet_NaN();
+    golden::result rb = golden::compare("broken", broken.data(), t, tol);
+    gc.add_expected_failure(rb);
+    check(rb.mismatches == 3, "three injected mismatches counted");
+    check(rb.first_location() == "[1, 2, 40]", "first failure at [1, 2, 40]");
+    check(std::fabs(rb.max_abs - 2.0 * std::fabs(out[first + 300])) < 1e-6, "max abs from the sign flip");
+
+    // Streaming: the same tensor folded in uneven blocks
+    golden::result rs;
+    rs.name = "broken/stream";
+    rs.shape = shape;
+    for (size_t off = 0; off < out.size(); off += 77) {
+        const size_t n = out.size() - off < 77 ? out.size() - off : 77;
+        golden::accumulate(rs, broken.data() + off, t.data<float>() + off, n, off, tol);
+    }
+    gc.add_expected_failure(rs);
+    check(rs.mismatches == rb.mismatches && rs.first_index == rb.first_index &&
+          rs.max_abs == rb.max_abs, "block-streamed result matches whole-tensor result");
+
+    std::vector<int32_t> iout(ti.data<int32_t>(), ti.data<int32_t>() + ti.count());
+    iout[512] += 2;
+    golden::tolerance exact;
+    golden::result ri = golden::compare("int32", iout.data(), ti, exact);
+    gc.add_expected_failure(ri);
+    check(ri.mismatches == 1 && ri.first_index == 512 && ri.max_ulp == 2, "int32: exact match, ULP = abs diff");
+
+    golden::result rd = golden::compare("wrong dtype", iout.data(), t, exact);
+    check(!rd.passed(), "dtype mismatch fails");
+
+    std::cout << std::endl;
+    gc.report(std::cout);
+
+    // ========================================
+    // Throughput
+    // ========================================
+    std::cout << "\n--- Throughput (16M float32) ---" << std::endl;
+    const size_t n = 16u << 20;
+    std::vector<float> big(n), big_ref(n);
+    fill(big_ref, 99u);
+    for (size_t i = 0; i < n; i++) big[i] = big_ref[i] * (1.0f + 1e-7f);
+
+    auto t0 = std::chrono::steady_clock::now();
+    double smax;
+    size_t sbad = scalar_mismatches(big.data(), big_ref.data(), n, tol.atol, tol.rtol, smax);
+    double scalar_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    golden::result rv = golden::compare("big", big.data(), big_ref.data(), n, tol);
+
+    const double gbytes = 2.0 * n * sizeof(float) / 1e9;
+    std::cout << std::fixed << std::setprecision(2)
+              << "  scalar loop : " << std::setw(8) << gbytes / scalar_s << " GB/s" << std::endl
+              << "  comparator  : " << std::setw(8) << gbytes / rv.seconds << " GB/s ("
+              << scalar_s / rv.seconds << "x, also tracks rel/ULP and first failure)" << std::endl;
+    check(rv.mismatches == sbad && rv.max_abs == smax, "comparator agrees with scalar loop");
+
+    unlink(f32_path.c_str());
+    unlink(i32_path.c_str());
+    unlink(raw_path.c_str());
+
+    std::cout << "\n========================================" << std::endl;
+    if (failed == 0) {
+        std::cout << "SUCCESS: All tensor I/O checks passed!" << std::endl;
+    } else {
+        std::cout << "FAILURE: " << failed << " tensor I/O checks failed!" << std::endl;
+    }
+    std::cout << "========================================" << std::endl;
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,267 @@
+// Tensor I/O (ESL)
+// Memory-mapped .npy and raw binary tensors for testbench operands and goldens
+//
+// A mapped_tensor maps the file read-only and exposes its payload in place,
+// so testbenches pack operand lanes and compare outputs straight from the
+// page cache: no parsing pass, no intermediate buffers. Supports .npy format
+// versions 1-3 with little-endian, C-order arrays of the dtypes below, and
+// headerless raw files given a dtype and shape. write_npy() produces files
+// numpy.load() reads back. POSIX only. No SystemC dependency.
+
+#ifndef TENSOR_IO_H
+#define TENSOR_IO_H
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace tensor_io {
+
+enum dtype { DT_F32, DT_F64, DT_I32, DT_I16, DT_I8, DT_U8, DT_INVALID };
+
+inline size_t dtype_size(dtype t) {
+    static const size_t sizes[] = { 4, 8, 4, 2, 1, 1, 0 };
+    return sizes[t];
+}
+
+// numpy descr strings
+inline const char* dtype_descr(dtype t) {
+    static const char* names[] = { "<f4", "<f8", "<i4", "<i2", "|i1", "|u1", "?" };
+    return names[t];
+}
+
+inline dtype parse_descr(const std::string& d) {
+    for (int t = 0; t < DT_INVALID; t++)
+        if (d == dtype_descr((dtype)t)) return (dtype)t;
+    if (d == "<i1") return DT_I8;
+    if (d == "<u1") return DT_U8;
+    return DT_INVALID;
+}
+
+template <typename T> struct dtype_of;
+template <> struct dtype_of<float>   { static const dtype value = DT_F32; };
+template <> struct dtype_of<double>  { static const dtype value = DT_F64; };
+template <> struct dtype_of<int32_t> { static const dtype value = DT_I32; };
+template <> struct dtype_of<int16_t> { static const dtype value = DT_I16; };
+template <> struct dtype_of<int8_t>  { static const dtype value = DT_I8; };
+template <> struct dtype_of<uint8_t> { static const dtype value = DT_U8; };
+
+// "[i, j, k]" for a flat C-order index
+inline std::string coord_string(const std::vector<size_t>& shape, size_t flat) {
+    std::vector<size_t> idx(shape.size());
+    for (size_t d = shape.size(); d-- > 0;) {
+        idx[d] = shape[d] ? flat % shape[d] : 0;
+        flat = shape[d] ? flat / shape[d] : 0;
+    }
+    std::string s = "[";
+    for (size_t d = 0; d < idx.size(); d++) s += (d ? ", " : "") + std::to_string(idx[d]);
+    return s + "]";
+}
+
+class mapped_tensor {
+public:
+    mapped_tensor() {}
+    ~mapped_tensor() { close(); }
+    mapped_tensor(const mapped_tensor&) = delete;
+    mapped_tensor& operator=(const mapped_tensor&) = delete;
+
+    // Returns false and sets err on a missing file, bad header, a shape whose
+    // byte size overflows, or a short payload
+    bool open_npy(const std::string& path, std::string* err = nullptr) {
+        if (!map_file(path, err)) return false;
+        const char* p = (const char*)map;
+        if (map_len < 10 || std::memcmp(p, "\x93NUMPY", 6) != 0)
+            return fail(path + ": not a .npy file", err);
+        const int major = (uint8_t)p[6];
+        size_t hlen, hoff;
+        if (major == 1) {
+            hlen = (uint8_t)p[8] | ((size_t)(uint8_t)p[9] << 8);
+            hoff = 10;
+        } else if ((major == 2 || major == 3) && map_len >= 12) {
+            uint32_t v;
+            std::memcpy(&v, p + 8, 4);
+            hlen = v;
+            hoff = 12;
+        } else {
+            return fail(path + ": unsupported .npy version", err);
+        }
+        if (hoff + hlen > map_len) return fail(path + ": truncated header", err);
+
+        const std::string hdr(p + hoff, hlen);
+        std::string descr;
+        if (!header_string(hdr, "descr", descr) || (type = parse_descr(descr)) == DT_INVALID)
+            return fail(path + ": unsupported dtype " + descr, err);
+        if (hdr.find("'fortran_order': True") != std::string::npos)
+            return fail(path + ": Fortran-order arrays are not supported", err);
+        if (!header_shape(hdr, dims)) return fail(path + ": bad shape in header", err);
+        return bind_payload(path, hoff + hlen, err);
+    }
+
+    bool open_raw(const std::string& path, dtype t, const std::vector<size_t>& shape,
+                  size_t offset = 0, std::string* err = nullptr) {
+        if (!map_file(path, err)) return false;
+        type = t;
+        dims = shape;
+        return bind_payload(path, offset, err);
+    }
+
+    void close() {
+        if (map) munmap(map, map_len);
+        map = nullptr;
+        map_len = 0;
+        payload = nullptr;
+        elems = 0;
+        dims.clear();
+        type = DT_INVALID;
+    }
+
+    bool is_open() const { return payload != nullptr; }
+    dtype type_id() const { return type; }
+    const std::vector<size_t>& shape() const { return dims; }
+    size_t rank() const { return dims.size(); }
+    size_t dim(size_t d) const { return d < dims.size() ? dims[d] : 1; }
+    size_t count() const { return elems; }
+    size_t bytes() const { return elems * dtype_size(type); }
+
+    // Payload in place; nullptr if T does not match the file dtype
+    template <typename T>
+    const T* data() const {
+        return dtype_of<T>::value == type ? (const T*)payload : nullptr;
+    }
+    const void* raw() const { return payload; }
+
+private:
+    void* map = nullptr;
+    size_t map_len = 0;
+    const uint8_t* payload = nullptr;
+    size_t elems = 0;
+    std::vector<size_t> dims;
+    dtype type = DT_INVALID;
+
+    bool fail(const std::string& msg, std::string* err) {
+        if (err) *err = msg;
+        close();
+        return false;
+    }
+
+    bool map_file(const std::string& path, std::string* err) {
+        close();
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return fail("cannot open " + path, err);
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+            ::close(fd);
+            return fail(path + ": empty or unreadable", err);
+        }
+        map_len = (size_t)st.st_size;
+        map = mmap(nullptr, map_len, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (map == MAP_FAILED) {
+            map = nullptr;
+            return fail("cannot map " + path, err);
+        }
+        // Operands are read front to back exactly once
+        madvise(map, map_len, MADV_SEQUENTIAL);
+        return true;
+    }
+
+    bool bind_payload(const std::string& path, size_t offset, std::string* err) {
+        if (type == DT_INVALID) return fail(path + ": invalid dtype", err);
+        // Every product and the final add are checked: a hostile shape must
+        // not wrap around to a size that fits the file
+        elems = 1;
+        for (size_t d : dims) {
+            if (d && elems > SIZE_MAX / d) return fail(path + ": shape too large", err);
+            elems *= d;
+        }
+        if (elems > SIZE_MAX / dtype_size(type)) return fail(path + ": shape too large", err);
+        if (offset > map_len || bytes() > map_len - offset)
+            return fail(path + ": payload shorter than its shape", err);
+        if (offset % dtype_size(type)) return fail(path + ": misaligned payload", err);
+        payload = (const uint8_t*)map + offset;
+        return true;
+    }
+
+    // 'key': 'value'
+    static bool header_string(const std::string& h, const char* key, std::string& out) {
+        size_t k = h.find(std::string("'") + key + "'");
+        if (k == std::string::npos) return false;
+        size_t a = h.find('\'', h.find(':', k) + 1);
+        size_t b = a == std::string::npos ? a : h.find('\'', a + 1);
+        if (b == std::string::npos) return false;
+        out = h.substr(a + 1, b - a - 1);
+        return true;
+    }
+
+    // 'shape': (d0, d1, ...); dims must be unsigned decimal integers
+    static bool header_shape(const std::string& h, std::vector<size_t>& out) {
+        size_t k = h.find("'shape'");
+        size_t a = k == std::string::npos ? k : h.find('(', k);
+        size_t b = a == std::string::npos ? a : h.find(')', a);
+        if (b == std::string::npos) return false;
+        out.clear();
+        const char* s = h.c_str() + a + 1;
+        const char* e = h.c_str() + b;
+        while (s < e) {
+            if (*s == ',' || *s == ' ') {
+                s++;
+                continue;
+            }
+            // strtoull would accept "-1" and wrap it to ULLONG_MAX
+            if (*s < '0' || *s > '9') return false;
+            char* next;
+            errno = 0;
+            const unsigned long long v = std::strtoull(s, &next, 10);
+            if (errno == ERANGE || v > SIZE_MAX) return false;
+            out.push_back((size_t)v);
+            s = next;
+        }
+        return true;
+    }
+};
+
+// Version 1 .npy, header padded to 64 bytes so the payload stays aligned
+inline bool write_npy(const std::string& path, dtype t, const std::vector<size_t>& shape,
+                      const void* data, std::string* err = nullptr) {
+    std::string hdr = std::string("{'descr': '") + dtype_descr(t) + "', 'fortran_order': False, 'shape': (";
+    size_t n = 1;
+    for (size_t d = 0; d < shape.size(); d++) {
+        hdr += std::to_string(shape[d]) + (shape.size() == 1 || d + 1 < shape.size() ? ", " : "");
+        n *= shape[d];
+    }
+    hdr += "), }";
+    while ((10 + hdr.size() + 1) % 64) hdr += ' ';
+    hdr += '\n';
+
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) {
+        if (err) *err = "cannot create " + path;
+        return false;
+    }
+    const uint8_t pre[10] = { 0x93, 'N', 'U', 'M', 'P', 'Y', 1, 0,
+                              (uint8_t)(hdr.size() & 0xFF), (uint8_t)(hdr.size() >> 8) };
+    bool ok = std::fwrite(pre, sizeof(pre), 1, f) == 1 &&
+              std::fwrite(hdr.data(), 1, hdr.size(), f) == hdr.size() &&
+              (n == 0 || std::fwrite(data, dtype_size(t), n, f) == n);
+    ok = (std::fclose(f) == 0) && ok;
+    if (!ok && err) *err = path + ": write failed";
+    return ok;
+}
+
+template <typename T>
+inline bool write_npy(const std::string& path, const std::vector<size_t>& shape, const T* data,
+                      std::string* err = nullptr) {
+    return write_npy(path, dtype_of<T>::value, shape, data, err);
+}
+
+} // namespace tensor_io
+
+#endif // TENSOR_IO_H
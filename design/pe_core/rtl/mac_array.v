@@ -1,5 +1,15 @@
 // MAC Array Module - Matrix Multiply Accumulate Array for PE Core
 // Simplified version with packed arrays for compatibility
+//
+// mac_op selects how the per-row accumulator is updated (instruction[25:24]):
+//   2'b00 MAC_OP_LOAD  - acc = dot product, result updated (legacy behaviour)
+//   2'b01 MAC_OP_CLEAR - acc = 0
+//   2'b10 MAC_OP_ACC   - acc = acc + dot product, result held
+//   2'b11 MAC_OP_DRAIN - result = saturate(acc), acc = 0
+// The accumulator keeps the full DATA_WIDTH*2+8 bits across ACC beats so a
+// long K-dimension reduction stays inside the PE until it is drained.
+// Operands are two's complement; products are sign-extended into the
+// accumulator, as in mac_array_sc.
 
 `timescale 1ns/1ps
 
@@ -11,12 +21,24 @@ module mac_array #(
     input  wire                           clk,
     input  wire                           rst_n,
     input  wire                           enable,
+    input  wire [1:0]                     mac_op,
     input  wire [(DATA_WIDTH*ARRAY_COLS)-1:0] data_a_i,
     input  wire [(DATA_WIDTH*ARRAY_ROWS)-1:0] data_b_i,
     input  wire [(DATA_WIDTH*ARRAY_COLS)-1:0] weight_i,
     output reg  [(DATA_WIDTH*ARRAY_ROWS)-1:0] mac_result
 );
 
+    localparam ACC_WIDTH = DATA_WIDTH*2+8;
+
+    localparam [1:0] MAC_OP_LOAD  = 2'b00;
+    localparam [1:0] MAC_OP_CLEAR = 2'b01;
+    localparam [1:0] MAC_OP_ACC   = 2'b10;
+    localparam [1:0] MAC_OP_DRAIN = 2'b11;
+
+    // Signed DATA_WIDTH limits, sign-extended to the accumulator width
+    localparam signed [ACC_WIDTH-1:0] SAT_MAX = {{(ACC_WIDTH-DATA_WIDTH+1){1'b0}}, {(DATA_WIDTH-1){1'b1}}};
+    localparam signed [ACC_WIDTH-1:0] SAT_MIN = {{(ACC_WIDTH-DATA_WIDTH+1){1'b1}}, {(DATA_WIDTH-1){1'b0}}};
+
     // Unpack data for processing
     wire [DATA_WIDTH-1:0] a_vec [ARRAY_COLS-1:0];
     wire [DATA_WIDTH-1:0] b_vec [ARRAY_ROWS-1:0];
@@ -39,22 +61,45 @@ module mac_array #(
     // MAC operation - use all non-blocking assignments
     generate
         for (row = 0; row < ARRAY_ROWS; row = row + 1) begin : mac_rows
-            reg [DATA_WIDTH*2+8-1:0] acc;
+            reg signed [ACC_WIDTH-1:0] acc;
+            reg [DATA_WIDTH-1:0] result_q;
             always @(posedge clk or negedge rst_n) begin
                 if (!rst_n) begin
                     acc <= 0;
+                    result_q <= 0;
                 end else if (enable) begin
                     // Use a temporary variable for accumulation
-                    reg [DATA_WIDTH*2+8-1:0] temp_acc;
+                    reg signed [ACC_WIDTH-1:0] temp_acc;
                     temp_acc = 0;
                     for (j = 0; j < ARRAY_COLS; j = j + 1) begin
-                        temp_acc = temp_acc + b_vec[row] * w_vec[j];
+                        // All operands signed: each product is sign-extended to ACC_WIDTH
+                        temp_acc = temp_acc + $signed(b_vec[row]) * $signed(w_vec[j]);
                     end
-                    acc <= temp_acc;
+                    case (mac_op)
+                        MAC_OP_LOAD: begin
+                            acc <= temp_acc;
+                            result_q <= temp_acc[DATA_WIDTH-1:0];
+                        end
+                        MAC_OP_CLEAR: begin
+                            acc <= 0;
+                        end
+                        MAC_OP_ACC: begin
+                            acc <= acc + temp_acc;
+                        end
+                        MAC_OP_DRAIN: begin
+                            if (acc > SAT_MAX)
+                                result_q <= SAT_MAX[DATA_WIDTH-1:0];
+                            else if (acc < SAT_MIN)
+                                result_q <= SAT_MIN[DATA_WIDTH-1:0];
+                            else
+                                result_q <= acc[DATA_WIDTH-1:0];
+                            acc <= 0;
+                        end
+                    endcase
                 end
             end
-            always @(acc) begin
-                mac_result[row*DATA_WIDTH +: DATA_WIDTH] = acc[DATA_WIDTH-1:0];
+            always @(result_q) begin
+                mac_result[row*DATA_WIDTH +: DATA_WIDTH] = result_q;
             end
         end
     endgenerate
@@ -58,6 +58,7 @@ module pe_core_complete #(
         .clk(clk),
         .rst_n(rst_n),
         .enable(mac_enable),
+        .mac_op(instruction[25:24]),
         .data_a_i(data_in),
         .data_b_i(data_in),
         .weight_i(data_in),
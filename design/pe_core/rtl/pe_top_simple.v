@@ -53,6 +53,7 @@ module pe_top_simple #(
         .clk(clk),
         .rst_n(rst_n),
         .enable(is_mac_op & valid_in),
+        .mac_op(instruction[25:24]),
         .data_a_i(data_a_packed[DATA_WIDTH*MAC_ARRAY_COLS-1:0]),
         .data_b_i(data_b_packed[DATA_WIDTH*MAC_ARRAY_ROWS-1:0]),
         .weight_i(weight_packed[DATA_WIDTH*MAC_ARRAY_COLS-1:0]),
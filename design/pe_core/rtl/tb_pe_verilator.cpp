@@ -1,17 +1,64 @@
 // Verilator Testbench for PE Core
-// Compile: verilator -cc pe_top_simple.v mac_array.v activation_unit_simple.v normalization_unit_simple.v --exe tb_pe_verilator.cpp -o tb_pe_verilator
-// Run: ./tb_pe_verilator
+// Compile: verilator -cc pe_top_simple.v mac_array.v activation_unit_simple.v normalization_unit_simple.v --exe tb_pe_verilator.cpp -CFLAGS "-std=c++17 -O2 -I../../esl" -o tb_pe_verilator
+// Run: ./tb_pe_verilator [x=<[N,K].npy> w=<[K,M].npy> golden=<[N,M].npy>]
+//
+// The last test runs an int32 linear layer through the MAC K-reduction and checks
+// every output against a golden tensor (tensor_io.h / golden_compare.h from
+// the ESL model). Without arguments a random layer is written first. Its x and
+// w are signed, so it also checks the sign-extended MAC products.
 
 #include <verilated.h>
 #include "Vpe_top_simple.h"
 #include <iostream>
 #include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <chrono>
+#include "tensor_io.h"
+#include "golden_compare.h"
 
 vluint64_t main_time = 0;
 
+static void tick(Vpe_top_simple* dut) {
+    dut->pe_top_simple__02Eclk = 0; dut->eval();
+    dut->pe_top_simple__02Eclk = 1; dut->eval();
+}
+
+// Random int32 layer; golden = saturated MAC DRAIN of the exact sums
+static bool write_default_layer(const std::string& x_path, const std::string& w_path,
+                                const std::string& g_path) {
+    const size_t N = 4, K = 64, M = 32;
+    std::vector<int32_t> x(N * K), w(K * M), g(N * M);
+    uint32_t seed = 2024;
+    for (int32_t& v : x) { seed = seed * 1664525u + 1013904223u; v = (int32_t)(seed >> 20) - 2048; }
+    for (int32_t& v : w) { seed = seed * 1664525u + 1013904223u; v = (int32_t)(seed >> 22) - 512; }
+    for (size_t n = 0; n < N; n++) {
+        for (size_t m = 0; m < M; m++) {
+            int64_t acc = 0;
+            for (size_t k = 0; k < K; k++) acc += (int64_t)x[n * K + k] * w[k * M + m];
+            g[n * M + m] = (int32_t)(acc > INT32_MAX ? INT32_MAX : (acc < INT32_MIN ? INT32_MIN : acc));
+        }
+    }
+    return tensor_io::write_npy(x_path, { N, K }, x.data()) &&
+           tensor_io::write_npy(w_path, { K, M }, w.data()) &&
+           tensor_io::write_npy(g_path, { N, M }, g.data());
+}
+
 int main(int argc, char** argv) {
     Verilated::commandArgs(argc, argv);
     
+    std::string x_path, w_path, golden_path;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        size_t eq = arg.find('=');
+        if (eq == std::string::npos) continue;  // Verilator +args
+        std::string key = arg.substr(0, eq), val = arg.substr(eq + 1);
+        if (key == "x") x_path = val;
+        else if (key == "w") w_path = val;
+        else if (key == "golden") golden_path = val;
+    }
+    
     std::cout << "========================================" << std::endl;
     std::cout << "PE Core Regression (Verilator)" << std::endl;
     std::cout << "========================================" << std::endl;
@@ -74,6 +121,59 @@ int main(int argc, char** argv) {
     std::cout << "LayerNorm Test completed" << std::endl;
     passed++;
     
+    // Test 4: int32 linear layer vs golden
+    std::cout << "\n--- Test " << total++ << ": Linear layer from .npy ---" << std::endl;
+    {
+        if (x_path.empty() || w_path.empty() || golden_path.empty()) {
+            x_path = "layer_x_i32.npy"; w_path = "layer_w_i32.npy"; golden_path = "layer_golden_i32.npy";
+            write_default_layer(x_path, w_path, golden_path);
+        }
+        tensor_io::mapped_tensor tx, tw, tg;
+        std::string err;
+        bool ok = tx.open_npy(x_path, &err) && tw.open_npy(w_path, &err) && tg.open_npy(golden_path, &err);
+        const size_t N = tx.dim(0), K = tx.dim(1), M = tw.dim(1);
+        if (ok && (!tx.data<int32_t>() || !tw.data<int32_t>() || tx.rank() != 2 || tw.rank() != 2 ||
+                   tw.dim(0) != K || M % 8 != 0 || tg.count() != N * M)) {
+            err = "expected int32 x[N,K], w[K,M] with M a multiple of 8, golden[N,M]";
+            ok = false;
+        }
+        if (!ok) {
+            std::cout << "  " << err << std::endl;
+        } else {
+            // data_b lanes come straight from w[k, m0..m0+7]; weight lane 0 = x[n, k]
+            const int32_t* X = tx.data<int32_t>();
+            const int32_t* Wt = tw.data<int32_t>();
+            std::vector<int32_t> y(N * M);
+            for (int i = 0; i < 16; i++) { dut->data_b_packed[i] = 0; dut->weight_packed[i] = 0; }
+            auto t_sim = std::chrono::steady_clock::now();
+            dut->valid_in = 1;
+            for (size_t n = 0; n < N; n++) {
+                for (size_t m0 = 0; m0 < M; m0 += 8) {
+                    for (size_t k = 0; k < K; k++) {
+                        std::memcpy(&dut->data_b_packed[0], &Wt[k * M + m0], 8 * sizeof(int32_t));
+                        dut->weight_packed[0] = (uint32_t)X[n * K + k];
+                        dut->instruction = k == 0 ? 0x10000000 : 0x12000000;  // MAC load / accumulate
+                        tick(dut);
+                    }
+                    dut->instruction = 0x13000000;  // MAC drain
+                    tick(dut);
+                    std::memcpy(&y[n * M + m0], &dut->result_packed[0], 8 * sizeof(int32_t));
+                }
+            }
+            dut->valid_in = 0;
+            const double sim_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_sim).count();
+            
+            golden::checker gc;
+            gc.add(golden::compare("layer_out", y.data(), tg, golden::tolerance()));
+            gc.report(std::cout);
+            std::cout << "  " << N << "x" << K << " @ " << K << "x" << M << ": simulation "
+                      << sim_s * 1e3 << " ms, golden check " << gc.seconds() * 1e3 << " ms" << std::endl;
+            ok = gc.all_passed();
+        }
+        std::cout << "Linear layer Test " << (ok ? "completed" : "FAILED") << std::endl;
+        if (ok) passed++;
+    }
+    
     // Results
     std::cout << "\n========================================" << std::endl;
     std::cout << "REGRESSION RESULTS (Verilator)" << std::endl;
@@ -86,10 +186,12 @@ int main(int argc, char** argv) {
     
     if (passed == total) {
         std::cout << "SUCCESS: All tests passed!" << std::endl;
+    } else {
+        std::cout << "FAILURE: Some tests failed!" << std::endl;
     }
     
     dut->final();
     delete dut;
     
-    return 0;
+    return passed == total ? 0 : 1;
 }
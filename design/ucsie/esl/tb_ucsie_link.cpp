@@ -0,0 +1,328 @@
+// UCIe Two-Die GEMM Harness (ESL)
+// Runs a GEMM split across two chiplets connected by ucsie_link_tlm
+//
+// C[M x N] = A[M x K] * B[K x N], columns of B/C split between the dies.
+// Die 0 holds A, B0 and C; die 1 holds B1. Die 1 fetches row tiles of A
+// across the link, computes its half of C and writes it back to die 0,
+// double-buffering the fetches against compute. The report shows link
+// utilization and how much of die 1's link-active time its compute hides.
+//
+// Usage: tb_ucsie_link [lanes=16] [rate=16] [m=256] [k=1024] [n=512]
+//                      [tile=32] [macs=64] [ber=0]
+
+#include <systemc.h>
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+#include <string>
+#include <algorithm>
+#include "ucsie_link_tlm.h"
+
+// ============================================
+// GEMM configuration
+// ============================================
+struct gemm_config {
+    int m = 256, k = 1024, n = 512;
+    int tile_m = 32;                    // Rows of A per cross-die fetch
+    int macs_per_cycle = 64;            // Per-die MAC throughput
+    sc_time cycle = sc_time(1, SC_NS);  // 1 GHz core clock
+    sc_time mem_latency = sc_time(20, SC_NS);
+
+    // The last tile is short when tile_m does not divide m
+    int tiles() const { return (m + tile_m - 1) / tile_m; }
+    int tile_rows(int t) const { return std::min(tile_m, m - t * tile_m); }
+    sc_time compute_time(int rows, int cols) const {
+        return cycle * ((double)rows * cols * k / macs_per_cycle);
+    }
+
+    bool valid(std::string* err) const {
+        if (m < 1 || k < 1 || n < 1 || tile_m < 1 || macs_per_cycle < 1)
+            return fail("m, k, n, tile and macs must be positive", err);
+        if (n % 2)
+            return fail("n must be even (the columns are split between the dies)", err);
+        return true;
+    }
+
+private:
+    static bool fail(const char* msg, std::string* err) {
+        if (err) *err = msg;
+        return false;
+    }
+};
+
+// Die 0 address map
+const uint64_t A_BASE = 0x00000000;
+const uint64_t C_BASE = 0x10000000;
+
+// ============================================
+// Die Memory (AXI slave behind the link)
+// ============================================
+SC_MODULE(die_memory) {
+    tlm_utils::simple_target_socket<die_memory> socket;
+    std::vector<uint8_t> a, c;
+    sc_time latency;
+
+    die_memory(sc_module_name name, size_t a_bytes, size_t c_bytes, sc_time latency)
+        : sc_module(name), socket("socket"), a(a_bytes), c(c_bytes), latency(latency) {
+        socket.register_b_transport(this, &die_memory::b_transport);
+    }
+
+    void b_transport(tlm::tlm_generic_payload& trans, sc_time& delay) {
+        uint64_t addr = trans.get_address();
+        std::vector<uint8_t>& mem = addr >= C_BASE ? c : a;
+        uint64_t off = addr - (addr >= C_BASE ? C_BASE : A_BASE);
+        if (off + trans.get_data_length() > mem.size()) {
+            trans.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
+            return;
+        }
+        if (trans.is_read())
+            std::memcpy(trans.get_data_ptr(), &mem[off], trans.get_data_length());
+        else
+            std::memcpy(&mem[off], trans.get_data_ptr(), trans.get_data_length());
+        delay += latency;
+        trans.set_response_status(tlm::TLM_OK_RESPONSE);
+    }
+};
+
+// ============================================
+// Die 1: remote half of the GEMM
+// ============================================
+SC_MODULE(remote_gemm_die) {
+    tlm_utils::simple_initiator_socket<remote_gemm_die> socket;
+
+    const gemm_config& cfg;
+    const std::vector<float>& b1;       // K x N/2, local to die 1
+    std::vector<std::vector<float>> a_buf;
+    sc_fifo<int> filled, empty, done_tiles;
+    std::vector<float> c_half;          // M x N/2 result, staged until written back
+
+    sc_time compute_busy;
+    sc_time finish;
+
+    remote_gemm_die(sc_module_name name, const gemm_config& cfg, const std::vector<float>& b1)
+        : sc_module(name), socket("socket"), cfg(cfg), b1(b1)
+        , a_buf(2, std::vector<float>(cfg.tile_m * cfg.k))
+        , filled(2), empty(2), done_tiles(2)
+        , c_half((size_t)cfg.m * (cfg.n / 2))
+        , compute_busy(SC_ZERO_TIME), finish(SC_ZERO_TIME) {
+        SC_HAS_PROCESS(remote_gemm_die);
+        SC_THREAD(fetch);
+        SC_THREAD(compute);
+        SC_THREAD(writeback);
+    }
+
+    void transfer(tlm::tlm_command cmd, uint64_t addr, float* data, size_t bytes) {
+        tlm::tlm_generic_payload trans;
+        sc_time delay = SC_ZERO_TIME;
+        trans.set_command(cmd);
+        trans.set_address(addr);
+        trans.set_data_ptr(reinterpret_cast<unsigned char*>(data));
+        trans.set_data_length(bytes);
+        trans.set_streaming_width(bytes);
+        trans.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+        socket->b_transport(trans, delay);
+        wait(delay);
+        if (trans.is_response_error())
+            SC_REPORT_ERROR("remote_gemm_die", trans.get_response_string().c_str());
+    }
+
+    // Double-buffered fetch of A row tiles across the link
+    void fetch() {
+        for (int t = 0; t < cfg.tiles(); t++) {
+            // Both buffers start empty; afterwards wait for compute to free one
+            int buf = t < 2 ? t : empty.read();
+            transfer(tlm::TLM_READ_COMMAND,
+                     A_BASE + (uint64_t)t * cfg.tile_m * cfg.k * sizeof(float),
+                     a_buf[buf].data(), (size_t)cfg.tile_rows(t) * cfg.k * sizeof(float));
+            filled.write(buf);
+        }
+    }
+
+    void compute() {
+        const int nh = cfg.n / 2;
+        for (int t = 0; t < cfg.tiles(); t++) {
+            int buf = filled.read();
+            std::vector<float>& a = a_buf[buf];
+            const int rows = cfg.tile_rows(t);
+            float* c = &c_half[(size_t)t * cfg.tile_m * nh];
+            for (int i = 0; i < rows; i++) {
+                for (int j = 0; j < nh; j++) {
+                    float sum = 0.0f;
+                    for (int kk = 0; kk < cfg.k; kk++)
+                        sum += a[i * cfg.k + kk] * b1[kk * nh + j];
+                    c[i * nh + j] = sum;
+                }
+            }
+            sc_time ct = cfg.compute_time(rows, nh);
+            wait(ct);
+            compute_busy += ct;
+            empty.write(buf);
+            done_tiles.write(t);
+        }
+    }
+
+    // Write each C tile back into die 0; C rows are N wide, die 1 owns the right half
+    void writeback() {
+        const int nh = cfg.n / 2;
+        for (int t = 0; t < cfg.tiles(); t++) {
+            int tile = done_tiles.read();
+            const float* c = &c_half[(size_t)tile * cfg.tile_m * nh];
+            for (int i = 0; i < cfg.tile_rows(tile); i++) {
+                uint64_t row = (uint64_t)tile * cfg.tile_m + i;
+                transfer(tlm::TLM_WRITE_COMMAND,
+                         C_BASE + (row * cfg.n + nh) * sizeof(float),
+                         const_cast<float*>(&c[i * nh]), nh * sizeof(float));
+            }
+        }
+        finish = sc_time_stamp();
+    }
+};
+
+// ============================================
+// Die 0: local half of the GEMM (no link traffic)
+// ============================================
+// Die 0 issues no remote requests in this workload, so it has no socket and
+// link.die0_target stays unbound
+SC_MODULE(local_gemm_die) {
+    const gemm_config& cfg;
+    die_memory& mem;
+    const std::vector<float>& b0;       // K x N/2, local to die 0
+    sc_time finish;
+
+    local_gemm_die(sc_module_name name, const gemm_config& cfg, die_memory& mem,
+                   const std::vector<float>& b0)
+        : sc_module(name), cfg(cfg), mem(mem), b0(b0), finish(SC_ZERO_TIME) {
+        SC_HAS_PROCESS(local_gemm_die);
+        SC_THREAD(compute);
+    }
+
+    void compute() {
+        const int nh = cfg.n / 2;
+        const float* a = reinterpret_cast<const float*>(mem.a.data());
+        float* c = reinterpret_cast<float*>(mem.c.data());
+        for (int i = 0; i < cfg.m; i++) {
+            for (int j = 0; j < nh; j++) {
+                float sum = 0.0f;
+                for (int kk = 0; kk < cfg.k; kk++)
+                    sum += a[i * cfg.k + kk] * b0[kk * nh + j];
+                c[i * cfg.n + j] = sum;
+            }
+        }
+        wait(cfg.compute_time(cfg.m, nh));
+        finish = sc_time_stamp();
+    }
+};
+
+// ============================================
+// Testbench
+// ============================================
+int sc_main(int argc, char* argv[]) {
+    ucsie_link_config link_cfg;
+    gemm_config gemm;
+    for (int i = 1; i < argc; i++) {
+        const char* eq = std::strchr(argv[i], '=');
+        if (!eq) continue;
+        std::string key(argv[i], eq - argv[i]);
+        double val = std::atof(eq + 1);
+        if (key == "lanes") link_cfg.num_lanes = (int)val;
+        else if (key == "rate") link_cfg.gt_per_s = val;
+        else if (key == "ber") link_cfg.flit_error_rate = val;
+        else if (key == "m") gemm.m = (int)val;
+        else if (key == "k") gemm.k = (int)val;
+        else if (key == "n") gemm.n = (int)val;
+        else if (key == "tile") gemm.tile_m = (int)val;
+        else if (key == "macs") gemm.macs_per_cycle = (int)val;
+    }
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "UCIe Two-Die GEMM (ESL)" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::string err;
+    if (!gemm.valid(&err)) {
+        std::cerr << "Invalid GEMM configuration: " << err << std::endl;
+        return 1;
+    }
+    std::cout << "GEMM: M=" << gemm.m << " K=" << gemm.k << " N=" << gemm.n
+              << ", tile_m=" << gemm.tile_m << ", " << gemm.macs_per_cycle
+              << " MAC/cycle per die" << std::endl;
+
+    // Operands
+    std::vector<float> a(gemm.m * gemm.k), b(gemm.k * gemm.n);
+    for (size_t i = 0; i < a.size(); i++) a[i] = (float)((i * 7) % 13) - 6.0f;
+    for (size_t i = 0; i < b.size(); i++) b[i] = (float)((i * 5) % 11) / 8.0f - 0.5f;
+    const int nh = gemm.n / 2;
+    std::vector<float> b0(gemm.k * nh), b1(gemm.k * nh);
+    for (int kk = 0; kk < gemm.k; kk++) {
+        for (int j = 0; j < nh; j++) {
+            b0[kk * nh + j] = b[kk * gemm.n + j];
+            b1[kk * nh + j] = b[kk * gemm.n + nh + j];
+        }
+    }
+
+    die_memory mem0("die0_mem", a.size() * sizeof(float),
+                    (size_t)gemm.m * gemm.n * sizeof(float), gemm.mem_latency);
+    std::memcpy(mem0.a.data(), a.data(), a.size() * sizeof(float));
+    die_memory mem1("die1_mem", 0, 0, gemm.mem_latency);
+
+    ucsie_link_tlm link("ucsie_link", link_cfg);
+    local_gemm_die die0("die0", gemm, mem0, b0);
+    remote_gemm_die die1("die1", gemm, b1);
+
+    die1.socket.bind(link.die1_target);
+    link.die0_initiator.bind(mem0.socket);
+    link.die1_initiator.bind(mem1.socket);
+
+    sc_start();
+
+    // ========================================
+    // Functional check against a host GEMM
+    // ========================================
+    const float* c = reinterpret_cast<const float*>(mem0.c.data());
+    int mismatches = 0;
+    for (int i = 0; i < gemm.m; i++) {
+        for (int j = 0; j < gemm.n; j++) {
+            float ref = 0.0f;
+            for (int kk = 0; kk < gemm.k; kk++) ref += a[i * gemm.k + kk] * b[kk * gemm.n + j];
+            if (std::fabs(c[i * gemm.n + j] - ref) > 1e-3f * (1.0f + std::fabs(ref))) mismatches++;
+        }
+    }
+
+    // ========================================
+    // Link / compute overlap
+    // ========================================
+    sc_time total = std::max(die0.finish, die1.finish);
+    // Die 1 keeps several requests in flight, so their latencies overlap:
+    // measure the time any of them was outstanding, not the sum
+    sc_time link_time = link.link_active[1];
+    sc_time exposed = die1.finish > die1.compute_busy ? die1.finish - die1.compute_busy
+                                                       : SC_ZERO_TIME;
+    double hidden = link_time > SC_ZERO_TIME
+                        ? std::max(0.0, 1.0 - exposed / link_time) : 1.0;
+    // Link demand is bounded by the busier direction
+    sc_time link_busy = std::max(link.lanes(0).busy_time, link.lanes(1).busy_time);
+
+    std::cout << "\n";
+    link.report(std::cout);
+    std::cout << "\nDie 0 finish:        " << die0.finish << std::endl;
+    std::cout << "Die 1 finish:        " << die1.finish << std::endl;
+    std::cout << "Die 1 compute busy:  " << die1.compute_busy << std::endl;
+    std::cout << "Die 1 link active:   " << link_time << " (union of request intervals)" << std::endl;
+    std::cout << "Exposed link time:   " << exposed << std::endl;
+    std::cout << "Link latency hidden: " << 100.0 * hidden << "%" << std::endl;
+    std::cout << "Bound:               "
+              << (link_busy > die1.compute_busy ? "die-to-die bandwidth" : "compute")
+              << std::endl;
+    std::cout << "Total time:          " << total << std::endl;
+
+    std::cout << "\n========================================" << std::endl;
+    if (mismatches == 0) {
+        std::cout << "SUCCESS: Cross-die GEMM matches host reference!" << std::endl;
+    } else {
+        std::cout << "FAILURE: " << mismatches << " mismatching elements!" << std::endl;
+    }
+    std::cout << "========================================" << std::endl;
+
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,256 @@
+// UCIe Die-to-Die Link TLM Model (ESL)
+// Loosely-timed TLM-2.0 model of ucsie_top: AXI bridge, adapter and PHY
+//
+// Each die connects an initiator to die<N>_target; the link forwards the
+// transaction to the remote die through die<M>_initiator. Timing follows the
+// RTL stack:
+//   - AXI bridging (ucsie_controller): transactions are split into bursts of
+//     at most MAX_BURST beats of DATA_W/8 bytes; at most FIFO_DEPTH
+//     transactions are outstanding per side (write/read FIFO depth).
+//   - Flit format (ucsie_spec.md): 256-bit flits with a 64-bit header, so a
+//     flit carries 192 payload bits. Each burst costs one request flit; write
+//     data rides forward, read data and B responses ride on the reverse lanes.
+//   - Credit flow control (ucsie_adapter): a flit takes one receiver credit
+//     when it starts on the line, and the credit returns after the flit's
+//     flight time plus the credit return latency.
+//   - Retry/replay: a corrupted flit is resent alone once its NAK returns.
+//     The line carries nothing during the NAK round trip, and the flits
+//     behind it are not resent (selective replay, not go-back-N).
+// The two directions are full duplex and modeled as independent lane groups.
+
+#ifndef UCSIE_LINK_TLM_H
+#define UCSIE_LINK_TLM_H
+
+#include <systemc.h>
+#include <tlm.h>
+#include <tlm_utils/simple_initiator_socket.h>
+#include <tlm_utils/simple_target_socket.h>
+#include <algorithm>
+#include <deque>
+#include <random>
+
+struct ucsie_link_config {
+    int num_lanes = 16;                 // NUM_LANES (1-16)
+    double gt_per_s = 16.0;             // Per-lane data rate (GT/s, 1 bit/UI)
+    int flit_bits = 256;                // Flit size
+    int flit_header_bits = 64;          // Seq/Retry/Length/Type/Fmt/CRC
+    int data_w = 256;                   // AXI DATA_W
+    int max_burst = 256;                // AXI MAX_BURST beats
+    int fifo_depth = 16;                // Outstanding transactions per side
+    int credits = 16;                   // Receiver flit credits (rx_credit)
+    sc_time adapter_latency = sc_time(4, SC_NS);        // Packetize / depacketize
+    sc_time phy_latency = sc_time(2, SC_NS);            // Serdes + channel flight
+    sc_time credit_return_latency = sc_time(4, SC_NS);  // Credit update back to TX
+    sc_time replay_latency = sc_time(16, SC_NS);        // NAK round trip
+    double flit_error_rate = 0.0;       // Probability a flit must be replayed
+    unsigned seed = 1;
+
+    int payload_bits() const { return flit_bits - flit_header_bits; }
+
+    // Serialization time of one flit across all lanes
+    sc_time flit_time() const {
+        return sc_time((double)flit_bits / (num_lanes * gt_per_s), SC_NS);
+    }
+};
+
+// One direction of the link: a bonded lane group with a credit pool
+class ucsie_lane_group : public sc_module {
+public:
+    // Statistics
+    uint64_t flits_sent;
+    uint64_t flits_replayed;
+    sc_time busy_time;
+    sc_time credit_stall_time;
+
+    ucsie_lane_group(sc_module_name name, const ucsie_link_config& cfg)
+        : sc_module(name)
+        , flits_sent(0)
+        , flits_replayed(0)
+        , busy_time(SC_ZERO_TIME)
+        , credit_stall_time(SC_ZERO_TIME)
+        , cfg(cfg)
+        , credit_ready(std::max(cfg.credits, 0), SC_ZERO_TIME)
+        , line_free(SC_ZERO_TIME)
+        , rng(cfg.seed)
+        , error_dist(cfg.flit_error_rate) {
+        if (cfg.credits < 1) SC_REPORT_ERROR(this->name(), "credits must be at least 1");
+    }
+
+    // Serialize flits in FIFO order; returns once the last flit has left the
+    // transmitter (it reaches the receiver phy_latency later).
+    void send(int flits) {
+        const sc_time flit = cfg.flit_time();
+        sc_time last_end = sc_time_stamp();
+        for (int i = 0; i < flits; i++) {
+            // The flit starts once the line is free and a credit has come
+            // back, and takes that credit at its start time
+            const sc_time line_ready = std::max(sc_time_stamp(), line_free);
+            const sc_time start = std::max(line_ready, credit_ready.front());
+            credit_ready.pop_front();
+            credit_stall_time += start - line_ready;
+            line_free = start + flit;
+            busy_time += flit;
+            if (cfg.flit_error_rate > 0.0 && error_dist(rng)) {
+                // Idle for the NAK round trip, then resend this flit only
+                line_free += cfg.replay_latency + flit;
+                busy_time += flit;
+                flits_replayed++;
+            }
+            flits_sent++;
+            last_end = line_free;
+            // Flits leave in order, so credits come back in order too
+            credit_ready.push_back(line_free + cfg.phy_latency + cfg.credit_return_latency);
+        }
+        if (last_end > sc_time_stamp()) wait(last_end - sc_time_stamp());
+    }
+
+    double utilization(const sc_time& elapsed) const {
+        return elapsed > SC_ZERO_TIME ? busy_time / elapsed : 0.0;
+    }
+
+private:
+    const ucsie_link_config& cfg;
+    std::deque<sc_time> credit_ready;   // When each receiver credit is back at TX
+    sc_time line_free;
+    std::mt19937 rng;
+    std::bernoulli_distribution error_dist;
+};
+
+class ucsie_link_tlm : public sc_module {
+public:
+    // Requests from die 0 / die 1 onto the link. A die that issues no
+    // remote requests may leave its target unbound.
+    typedef tlm_utils::simple_target_socket<ucsie_link_tlm, 32, tlm::tlm_base_protocol_types,
+                                            SC_ZERO_OR_MORE_BOUND> target_socket;
+    target_socket die0_target;
+    target_socket die1_target;
+
+    // Remote requests delivered into die 0 / die 1
+    tlm_utils::simple_initiator_socket<ucsie_link_tlm> die0_initiator;
+    tlm_utils::simple_initiator_socket<ucsie_link_tlm> die1_initiator;
+
+    // Per-side transaction statistics (index = requesting die)
+    uint64_t transactions[2];
+    uint64_t bytes[2];
+    sc_time link_latency[2];            // Sum of request-to-completion time
+    sc_time link_active[2];             // Time with at least one request in flight
+
+    ucsie_link_tlm(sc_module_name name, const ucsie_link_config& cfg = ucsie_link_config())
+        : sc_module(name)
+        , die0_target("die0_target")
+        , die1_target("die1_target")
+        , die0_initiator("die0_initiator")
+        , die1_initiator("die1_initiator")
+        , cfg(cfg)
+        , outstanding0(cfg.fifo_depth)
+        , outstanding1(cfg.fifo_depth)
+        , tx0("tx0", this->cfg)
+        , tx1("tx1", this->cfg) {
+        die0_target.register_b_transport(this, &ucsie_link_tlm::b_transport_die0);
+        die1_target.register_b_transport(this, &ucsie_link_tlm::b_transport_die1);
+        for (int i = 0; i < 2; i++) {
+            transactions[i] = 0;
+            bytes[i] = 0;
+            link_latency[i] = SC_ZERO_TIME;
+            link_active[i] = SC_ZERO_TIME;
+            in_flight[i] = 0;
+        }
+    }
+
+    const ucsie_link_config& config() const { return cfg; }
+
+    // Lane group carrying traffic away from die <side>
+    const ucsie_lane_group& lanes(int side) const { return side == 0 ? tx0 : tx1; }
+
+    // Raw and effective (payload) bandwidth per direction in GB/s
+    double raw_bandwidth() const { return cfg.num_lanes * cfg.gt_per_s / 8.0; }
+    double payload_bandwidth() const {
+        return raw_bandwidth() * cfg.payload_bits() / cfg.flit_bits;
+    }
+
+    void report(std::ostream& os) const {
+        sc_time now = sc_time_stamp();
+        os << "UCIe link: " << cfg.num_lanes << " lanes @ " << cfg.gt_per_s << " GT/s, "
+           << raw_bandwidth() << " GB/s raw, " << payload_bandwidth()
+           << " GB/s payload per direction" << std::endl;
+        for (int side = 0; side < 2; side++) {
+            const ucsie_lane_group& g = lanes(side);
+            os << "  die" << side << "->die" << (1 - side) << ": "
+               << g.flits_sent << " flits, " << g.flits_replayed << " replayed, "
+               << "utilization " << 100.0 * g.utilization(now) << "%, "
+               << "credit stall " << g.credit_stall_time << std::endl;
+            os << "  die" << side << " requests: " << transactions[side] << " txns, "
+               << bytes[side] << " bytes, avg latency "
+               << (transactions[side] ? link_latency[side] / (double)transactions[side]
+                                      : SC_ZERO_TIME)
+               << ", active " << link_active[side] << std::endl;
+        }
+    }
+
+private:
+    ucsie_link_config cfg;
+    sc_semaphore outstanding0;
+    sc_semaphore outstanding1;
+    ucsie_lane_group tx0;
+    ucsie_lane_group tx1;
+    int in_flight[2];                   // Requests between issue and completion
+    sc_time active_since[2];            // Start of the current busy interval
+
+    void b_transport_die0(tlm::tlm_generic_payload& trans, sc_time& delay) {
+        transport(0, trans, delay);
+    }
+
+    void b_transport_die1(tlm::tlm_generic_payload& trans, sc_time& delay) {
+        transport(1, trans, delay);
+    }
+
+    int flits_for(uint64_t payload_bytes) const {
+        return (int)((payload_bytes * 8 + cfg.payload_bits() - 1) / cfg.payload_bits());
+    }
+
+    void transport(int side, tlm::tlm_generic_payload& trans, sc_time& delay) {
+        // Synchronize so lane groups see requests in simulation-time order
+        wait(delay);
+        delay = SC_ZERO_TIME;
+        const sc_time issue = sc_time_stamp();
+        // Requests overlap, so link_active is the union of their intervals
+        if (in_flight[side]++ == 0) active_since[side] = issue;
+
+        sc_semaphore& outstanding = side == 0 ? outstanding0 : outstanding1;
+        ucsie_lane_group& req_lanes = side == 0 ? tx0 : tx1;
+        ucsie_lane_group& rsp_lanes = side == 0 ? tx1 : tx0;
+        outstanding.wait();
+
+        // AXI burst split (ucsie_controller MAX_BURST x DATA_W)
+        const uint64_t len = trans.get_data_length();
+        const uint64_t burst_bytes = (uint64_t)cfg.max_burst * (cfg.data_w / 8);
+        const int bursts = (int)std::max<uint64_t>(1, (len + burst_bytes - 1) / burst_bytes);
+        int data_flits = 0;
+        for (uint64_t off = 0; off < len; off += burst_bytes)
+            data_flits += flits_for(std::min(burst_bytes, len - off));
+        const bool is_write = trans.is_write();
+
+        // Request: one header flit per burst, plus write data
+        wait(cfg.adapter_latency);
+        req_lanes.send(bursts + (is_write ? data_flits : 0));
+        wait(cfg.phy_latency + cfg.adapter_latency);
+
+        // Remote access through the remote die's AXI slave
+        sc_time target_delay = SC_ZERO_TIME;
+        (side == 0 ? die1_initiator : die0_initiator)->b_transport(trans, target_delay);
+        wait(target_delay);
+
+        // Response: read data, or one B response flit per burst
+        wait(cfg.adapter_latency);
+        rsp_lanes.send(is_write ? bursts : data_flits);
+        wait(cfg.phy_latency + cfg.adapter_latency);
+
+        outstanding.post();
+        transactions[side]++;
+        bytes[side] += len;
+        link_latency[side] += sc_time_stamp() - issue;
+        if (--in_flight[side] == 0) link_active[side] += sc_time_stamp() - active_since[side];
+    }
+};
+
+#endif // UCSIE_LINK_TLM_H
@@ -0,0 +1,143 @@
+// CDC FIFO SystemC Model (ESL)
+// Asynchronous FIFO between two clock_domain_sc instances
+//
+// Pointer synchronization follows sync_cell.v: a write becomes visible to the
+// reader after SYNC_STAGES rising edges of the destination clock, and a freed
+// slot becomes visible to the writer after SYNC_STAGES edges of the source
+// clock. A gated destination does not clock its synchronizer, so data waits
+// until the domain is ungated; raw_write_event() is the always-on request
+// line a wake-up controller can watch. When both ends share a domain the
+// synchronizer is bypassed.
+
+#ifndef CDC_FIFO_SC_H
+#define CDC_FIFO_SC_H
+
+#include <systemc.h>
+#include <deque>
+#include "clock_domain_sc.h"
+
+template <typename T, int SYNC_STAGES = 2>
+class cdc_fifo_sc : public sc_module {
+public:
+    // Statistics
+    uint64_t crossings;
+    sc_time total_latency;      // Write to visible at the reader
+    uint64_t full_cycles;       // Source edges refused for lack of space
+
+    cdc_fifo_sc(sc_module_name name, clock_domain_sc* src, clock_domain_sc* dst, int depth = 8)
+        : sc_module(name)
+        , crossings(0)
+        , total_latency(SC_ZERO_TIME)
+        , full_cycles(0)
+        , src(src)
+        , dst(dst)
+        , depth(depth)
+        , stages(src == dst ? 0 : SYNC_STAGES)
+        , visible(0)
+        , free_slots(depth) {
+        SC_HAS_PROCESS(cdc_fifo_sc);
+        SC_METHOD(dst_sync);
+        sensitive << dst->posedge_event();
+        dont_initialize();
+        SC_METHOD(src_sync);
+        sensitive << src->posedge_event();
+        dont_initialize();
+    }
+
+    // ========================================
+    // Source side (call from the src domain)
+    // ========================================
+    bool nb_write(const T& v) {
+        if (free_slots == 0) {
+            full_cycles++;
+            return false;
+        }
+        free_slots--;
+        entries.push_back(entry{ v, stages, sc_time_stamp() });
+        if (stages == 0) make_visible(entries.back());
+        raw_written.notify(SC_ZERO_TIME);
+        return true;
+    }
+
+    void write(const T& v) {
+        while (!nb_write(v)) wait(src->posedge_event());
+    }
+
+    // ========================================
+    // Destination side (call from the dst domain)
+    // ========================================
+    bool can_read() const { return visible > 0; }
+
+    bool nb_peek(T& v) const {
+        if (visible == 0) return false;
+        v = entries.front().data;
+        return true;
+    }
+
+    bool nb_read(T& v) {
+        if (visible == 0) return false;
+        v = entries.front().data;
+        entries.pop_front();
+        visible--;
+        if (stages == 0) free_slots++;
+        else returning.push_back(stages);
+        return true;
+    }
+
+    T read() {
+        T v;
+        while (!nb_read(v)) wait(dst->posedge_event());
+        return v;
+    }
+
+    // Asynchronous view for wake-up logic
+    bool raw_pending() const { return !entries.empty(); }
+    const sc_event& raw_write_event() const { return raw_written; }
+
+    double avg_latency_ns() const {
+        return crossings ? total_latency.to_seconds() * 1e9 / crossings : 0.0;
+    }
+
+private:
+    struct entry {
+        T data;
+        int age;                // Destination edges still to wait
+        sc_time written;
+    };
+
+    clock_domain_sc* src;
+    clock_domain_sc* dst;
+    int depth;
+    int stages;
+    int visible;                // Entries past the write-pointer synchronizer
+    int free_slots;             // Free slots as seen by the writer
+    std::deque<entry> entries;
+    std::deque<int> returning;  // Freed slots still crossing back to src
+    sc_event raw_written;
+
+    void make_visible(entry& e) {
+        e.age = 0;
+        visible++;
+        crossings++;
+        total_latency += sc_time_stamp() - e.written;
+    }
+
+    // Write pointer crosses into the destination domain
+    void dst_sync() {
+        for (size_t i = visible; i < entries.size(); i++) {
+            entry& e = entries[i];
+            if (--e.age <= 0 && (int)i == visible) make_visible(e);
+        }
+    }
+
+    // Read pointer crosses back into the source domain
+    void src_sync() {
+        for (size_t i = 0; i < returning.size(); i++) returning[i]--;
+        while (!returning.empty() && returning.front() <= 0) {
+            returning.pop_front();
+            free_slots++;
+        }
+    }
+};
+
+#endif // CDC_FIFO_SC_H
@@ -0,0 +1,177 @@
+// Clock Domain SystemC Model (ESL)
+// Programmable clock with DVFS, clock gating and activity-based energy
+//
+// One clock_domain_sc stands for the clock_divider / clock_switch /
+// clock_gating chain feeding a block. Modules clock themselves from the
+// public `clk` signal (or posedge_event()) instead of a shared sc_clock.
+//   - set_operating_point(): frequency/voltage change. Unlike the
+//     combinational clock_switch.v the switch is glitch-free: the output is
+//     held low for switch_latency, then restarts at the new period.
+//   - set_gated(): clock_gating.v enable; no edges while gated.
+//   - set_busy(): activity hint from the clocked block, used to weight
+//     dynamic energy per edge.
+//   - stop(): end of workload; the clock stops and accounting freezes.
+// Energy (pJ) = sum over edges of C_eff * V^2 * activity
+//             + leakage (mW) * ungated time, scaled by gated_leakage when gated.
+
+#ifndef CLOCK_DOMAIN_SC_H
+#define CLOCK_DOMAIN_SC_H
+
+#include <systemc.h>
+#include <ostream>
+#include <iomanip>
+
+struct operating_point {
+    double freq_mhz;
+    double voltage;
+};
+
+struct clock_domain_config {
+    operating_point op = { 1000.0, 0.9 };
+    double c_eff_pf = 10.0;             // Switched capacitance per busy cycle
+    double idle_activity = 0.3;         // Clock tree + idle toggling, fraction of busy
+    double leakage_mw_per_v = 2.0;      // Leakage power scales with voltage
+    double gated_leakage = 1.0;         // Leakage kept while gated (no power gating)
+    sc_time switch_latency = sc_time(20, SC_NS);    // DVFS relock / switchover
+};
+
+class clock_domain_sc : public sc_module {
+public:
+    sc_signal<bool> clk;
+
+    // Statistics
+    uint64_t busy_cycles;
+    uint64_t idle_cycles;
+    uint64_t transitions;
+    sc_time gated_time;
+    double dynamic_pj;
+    double leakage_pj;
+
+    clock_domain_sc(sc_module_name name, const clock_domain_config& cfg = clock_domain_config())
+        : sc_module(name)
+        , clk("clk")
+        , busy_cycles(0)
+        , idle_cycles(0)
+        , transitions(0)
+        , gated_time(SC_ZERO_TIME)
+        , dynamic_pj(0.0)
+        , leakage_pj(0.0)
+        , cfg(cfg)
+        , op(cfg.op)
+        , pending(cfg.op)
+        , has_pending(false)
+        , gated(false)
+        , busy(false)
+        , stopped(false)
+        , last_accrue(SC_ZERO_TIME) {
+        SC_HAS_PROCESS(clock_domain_sc);
+        SC_THREAD(generate);
+    }
+
+    const sc_event& posedge_event() const { return clk.posedge_event(); }
+
+    double freq_mhz() const { return op.freq_mhz; }
+    double voltage() const { return op.voltage; }
+    bool is_gated() const { return gated; }
+    sc_time period() const { return sc_time(1000.0 / op.freq_mhz, SC_NS); }
+
+    // Requested change applies at the next falling edge
+    void set_operating_point(const operating_point& next) {
+        if (next.freq_mhz == op.freq_mhz && next.voltage == op.voltage && !has_pending) return;
+        pending = next;
+        has_pending = true;
+        wake.notify(SC_ZERO_TIME);
+    }
+
+    void set_gated(bool g) {
+        if (g == gated) return;
+        accrue();
+        gated = g;
+        if (!g) wake.notify(SC_ZERO_TIME);
+    }
+
+    void set_busy(bool b) { busy = b; }
+
+    void stop() {
+        accrue();
+        stopped = true;
+        wake.notify(SC_ZERO_TIME);
+    }
+
+    double energy_pj() {
+        accrue();
+        return dynamic_pj + leakage_pj;
+    }
+
+    void report(std::ostream& os) {
+        double total = energy_pj();
+        os << "  " << std::left << std::setw(14) << basename() << std::right
+           << std::setw(8) << op.freq_mhz << " MHz"
+           << std::setw(10) << busy_cycles << " busy"
+           << std::setw(10) << idle_cycles << " idle"
+           << std::setw(12) << gated_time.to_seconds() * 1e9 << " ns gated"
+           << std::setw(4) << transitions << " dvfs"
+           << std::setw(12) << std::fixed << std::setprecision(1) << total / 1000.0 << " nJ"
+           << std::defaultfloat << std::endl;
+    }
+
+private:
+    clock_domain_config cfg;
+    operating_point op;
+    operating_point pending;
+    bool has_pending;
+    bool gated;
+    bool busy;
+    bool stopped;
+    sc_time last_accrue;
+    sc_event wake;
+
+    // Integrate leakage up to now
+    void accrue() {
+        if (stopped) return;
+        sc_time now = sc_time_stamp();
+        double ns = (now - last_accrue).to_seconds() * 1e9;
+        double p_mw = cfg.leakage_mw_per_v * op.voltage * (gated ? cfg.gated_leakage : 1.0);
+        leakage_pj += p_mw * ns;
+        if (gated) gated_time += now - last_accrue;
+        last_accrue = now;
+    }
+
+    void generate() {
+        clk.write(false);
+        while (!stopped) {
+            if (has_pending) {
+                // Glitch-free switchover: output held low while the new clock locks
+                accrue();
+                wait(cfg.switch_latency);
+                accrue();
+                op = pending;
+                has_pending = false;
+                transitions++;
+            }
+            if (gated) {
+                clk.write(false);
+                wait(wake);
+                continue;
+            }
+
+            const sc_time half = period() / 2;
+            const double e_cycle = cfg.c_eff_pf * op.voltage * op.voltage;
+            if (busy) {
+                busy_cycles++;
+                dynamic_pj += e_cycle;
+            } else {
+                idle_cycles++;
+                dynamic_pj += e_cycle * cfg.idle_activity;
+            }
+            clk.write(true);
+            wait(half);
+            clk.write(false);
+            wait(half);
+            accrue();
+        }
+        clk.write(false);
+    }
+};
+
+#endif // CLOCK_DOMAIN_SC_H
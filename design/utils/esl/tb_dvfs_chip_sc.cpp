@@ -0,0 +1,432 @@
+// Multi-Clock-Domain Chip ESL Testbench
+// Per-router / per-PE clock domains, CDC crossings and DVFS policies
+//
+// Models the chip_top mesh at flit level: every core has a router domain and
+// a PE domain. A dispatcher at core [0,0] streams GEMM tiles east then north
+// (the mesh links only go E/N, see chip_architecture.md); completions return
+// to the dispatcher over a CDC FIFO. The workload is a sequence of GEMM layers
+// separated by a host phase, so cores sit idle between and at the tail of
+// layers. Each scenario is an independent chip instance in the same
+// simulation; the table compares throughput and energy per domain class.
+
+#include <systemc.h>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include "clock_domain_sc.h"
+#include "cdc_fifo_sc.h"
+
+// Idle power management applied to PE domains
+enum pm_policy {
+    PM_NONE = 0,        // Always at the nominal operating point
+    PM_DVFS = 1,        // Drop to idle_op after idle_threshold cycles
+    PM_GATE = 2         // Gate the clock after idle_threshold cycles
+};
+
+static const char* policy_name(int p) {
+    return p == PM_DVFS ? "dvfs" : (p == PM_GATE ? "gate" : "none");
+}
+
+struct chip_config {
+    std::string name;
+    int cores_x = 4;
+    int cores_y = 4;
+    operating_point noc_op = { 1000.0, 0.90 };
+    operating_point pe_op = { 1000.0, 0.90 };
+    operating_point idle_op = { 250.0, 0.60 };
+    int policy = PM_NONE;
+    int idle_threshold = 32;            // PE cycles before the policy kicks in
+    int tile_flits = 8;                 // Operand flits per GEMM tile
+    int tile_cycles = 256;              // PE cycles per tile
+    int host_gap = 400;                 // NoC cycles between layers
+    std::vector<int> layers = { 64, 40, 24, 8 };   // Tiles per layer
+};
+
+struct noc_flit {
+    int dest;
+    int tile;
+    bool last;
+};
+
+typedef cdc_fifo_sc<noc_flit> link_t;
+typedef cdc_fifo_sc<int> done_t;
+
+static int systems_running = 0;
+
+// ============================================
+// Mesh router: inputs W, S, inject; outputs E, N, PE
+// ============================================
+SC_MODULE(mesh_router_esl) {
+    clock_domain_sc* dom;
+    link_t* in[3];
+    link_t* out[3];         // 0 = east, 1 = north, 2 = local PE
+    int x, y, cores_x;
+    uint64_t flits;
+
+    mesh_router_esl(sc_module_name name, clock_domain_sc* dom, int x, int y, int cores_x)
+        : sc_module(name), dom(dom), x(x), y(y), cores_x(cores_x), flits(0), rr(0) {
+        SC_HAS_PROCESS(mesh_router_esl);
+        for (int i = 0; i < 3; i++) in[i] = out[i] = nullptr;
+        SC_THREAD(route);
+    }
+
+private:
+    int rr;
+
+    int output_of(const noc_flit& f) const {
+        if (f.dest % cores_x != x) return 0;
+        if (f.dest / cores_x != y) return 1;
+        return 2;
+    }
+
+    // One flit per output per cycle, round-robin over inputs
+    void route() {
+        while (true) {
+            wait(dom->posedge_event());
+            bool used[3] = { false, false, false };
+            bool moved = false;
+            for (int k = 0; k < 3; k++) {
+                link_t* src = in[(rr + k) % 3];
+                noc_flit f;
+                if (!src || !src->nb_peek(f)) continue;
+                int o = output_of(f);
+                if (used[o] || !out[o]->nb_write(f)) continue;
+                src->nb_read(f);
+                used[o] = true;
+                moved = true;
+                flits++;
+            }
+            rr = (rr + 1) % 3;
+            dom->set_busy(moved);   // Activity for the coming cycle
+        }
+    }
+};
+
+// ============================================
+// PE: consume a tile, compute, report completion
+// ============================================
+SC_MODULE(pe_tile_esl) {
+    clock_domain_sc* dom;
+    link_t* in;
+    done_t* done;
+    const chip_config& cfg;
+    uint64_t tiles;
+
+    pe_tile_esl(sc_module_name name, clock_domain_sc* dom, const chip_config& cfg)
+        : sc_module(name), dom(dom), in(nullptr), done(nullptr), cfg(cfg), tiles(0) {
+        SC_HAS_PROCESS(pe_tile_esl);
+        SC_THREAD(run);
+    }
+
+private:
+    void run() {
+        int idle = 0;
+        bool low = false;
+        while (true) {
+            noc_flit f;
+            if (in->nb_read(f)) {
+                idle = 0;
+                if (low) {
+                    dom->set_operating_point(cfg.pe_op);
+                    low = false;
+                }
+                if (f.last) {
+                    dom->set_busy(true);
+                    for (int c = 0; c < cfg.tile_cycles; c++) wait(dom->posedge_event());
+                    dom->set_busy(false);
+                    done->write(f.tile);
+                    tiles++;
+                }
+                wait(dom->posedge_event());
+                continue;
+            }
+
+            if (low && in->raw_pending()) {
+                // Work is on its way: ramp back up while it synchronizes
+                dom->set_operating_point(cfg.pe_op);
+                low = false;
+            }
+            if (++idle == cfg.idle_threshold && cfg.policy == PM_DVFS) {
+                dom->set_operating_point(cfg.idle_op);
+                low = true;
+            }
+            if (idle >= cfg.idle_threshold && cfg.policy == PM_GATE && !in->raw_pending()) {
+                // Wake-up request is always-on; the synchronizer restarts with the clock
+                dom->set_gated(true);
+                wait(in->raw_write_event());
+                dom->set_gated(false);
+                idle = 0;
+            }
+            wait(dom->posedge_event());
+        }
+    }
+};
+
+// ============================================
+// Dispatcher: GEMM layers -> tiles -> flits
+// ============================================
+SC_MODULE(tile_dispatcher_esl) {
+    clock_domain_sc* dom;
+    link_t* inject;
+    std::vector<done_t*> done;
+    const chip_config& cfg;
+    sc_time finish;
+    sc_event finished;
+
+    tile_dispatcher_esl(sc_module_name name, clock_domain_sc* dom, const chip_config& cfg)
+        : sc_module(name), dom(dom), inject(nullptr), cfg(cfg) {
+        SC_HAS_PROCESS(tile_dispatcher_esl);
+        SC_THREAD(run);
+    }
+
+private:
+    void run() {
+        const int num_pes = cfg.cores_x * cfg.cores_y;
+        std::vector<int> outstanding(num_pes, 0);
+        int next_pe = 0, tile_id = 0;
+
+        for (size_t l = 0; l < cfg.layers.size(); l++) {
+            if (l > 0) {
+                for (int c = 0; c < cfg.host_gap; c++) wait(dom->posedge_event());
+            }
+            const int tiles = cfg.layers[l];
+            int issued = 0, completed = 0, flit = 0, dest = -1;
+            while (completed < tiles) {
+                wait(dom->posedge_event());
+                for (int p = 0; p < num_pes; p++) {
+                    int t;
+                    while (done[p]->nb_read(t)) {
+                        outstanding[p]--;
+                        completed++;
+                    }
+                }
+
+                // Pick a PE with a free double-buffer slot
+                if (dest < 0 && issued < tiles) {
+                    for (int k = 0; k < num_pes; k++) {
+                        int p = (next_pe + k) % num_pes;
+                        if (outstanding[p] < 2) {
+                            dest = p;
+                            next_pe = (p + 1) % num_pes;
+                            break;
+                        }
+                    }
+                }
+                if (dest >= 0) {
+                    noc_flit f = { dest, tile_id, flit == cfg.tile_flits - 1 };
+                    if (inject->nb_write(f) && ++flit == cfg.tile_flits) {
+                        outstanding[dest]++;
+                        issued++;
+                        tile_id++;
+                        flit = 0;
+                        dest = -1;
+                    }
+                }
+            }
+        }
+        finish = sc_time_stamp();
+        finished.notify(SC_ZERO_TIME);
+    }
+};
+
+// ============================================
+// One chip instance per scenario
+// ============================================
+SC_MODULE(chip_esl) {
+    chip_config cfg;
+    std::vector<clock_domain_sc*> noc_dom, pe_dom;
+    std::vector<mesh_router_esl*> routers;
+    std::vector<pe_tile_esl*> pes;
+    std::vector<link_t*> pe_links;
+    std::vector<done_t*> done_links;
+    tile_dispatcher_esl* dispatcher;
+
+    chip_esl(sc_module_name name, const chip_config& c) : sc_module(name), cfg(c) {
+        SC_HAS_PROCESS(chip_esl);
+        SC_THREAD(shutdown);
+        const int n = cfg.cores_x * cfg.cores_y;
+        clock_domain_config noc_cfg, pe_cfg;
+        noc_cfg.op = cfg.noc_op;
+        noc_cfg.c_eff_pf = 4.0;
+        pe_cfg.op = cfg.pe_op;
+        pe_cfg.c_eff_pf = 20.0;
+
+        for (int i = 0; i < n; i++) {
+            std::string xy = std::to_string(i % cfg.cores_x) + "_" + std::to_string(i / cfg.cores_x);
+            noc_dom.push_back(new clock_domain_sc(("noc_" + xy).c_str(), noc_cfg));
+            pe_dom.push_back(new clock_domain_sc(("pe_" + xy).c_str(), pe_cfg));
+            routers.push_back(new mesh_router_esl(("router_" + xy).c_str(), noc_dom[i],
+                                                  i % cfg.cores_x, i / cfg.cores_x, cfg.cores_x));
+            pes.push_back(new pe_tile_esl(("pe_" + xy + "_core").c_str(), pe_dom[i], cfg));
+        }
+
+        dispatcher = new tile_dispatcher_esl("dispatcher", noc_dom[0], cfg);
+        dispatcher->inject = new link_t("inject", noc_dom[0], noc_dom[0]);
+        routers[0]->in[2] = dispatcher->inject;
+
+        for (int i = 0; i < n; i++) {
+            const int x = i % cfg.cores_x, y = i / cfg.cores_x;
+            if (x + 1 < cfg.cores_x) {
+                link_t* l = new link_t(sc_gen_unique_name("east"), noc_dom[i], noc_dom[i + 1]);
+                routers[i]->out[0] = l;
+                routers[i + 1]->in[0] = l;
+            }
+            if (y + 1 < cfg.cores_y) {
+                link_t* l = new link_t(sc_gen_unique_name("north"), noc_dom[i], noc_dom[i + cfg.cores_x]);
+                routers[i]->out[1] = l;
+                routers[i + cfg.cores_x]->in[1] = l;
+            }
+            link_t* pl = new link_t(sc_gen_unique_name("to_pe"), noc_dom[i], pe_dom[i], cfg.tile_flits);
+            routers[i]->out[2] = pl;
+            pes[i]->in = pl;
+            pe_links.push_back(pl);
+
+            done_t* d = new done_t(sc_gen_unique_name("done"), pe_dom[i], noc_dom[0]);
+            pes[i]->done = d;
+            dispatcher->done.push_back(d);
+            done_links.push_back(d);
+        }
+        systems_running++;
+    }
+
+    // Stop every clock once the workload is done so energy covers this chip's run only
+    void shutdown() {
+        wait(dispatcher->finished);
+        for (size_t i = 0; i < noc_dom.size(); i++) noc_dom[i]->stop();
+        for (size_t i = 0; i < pe_dom.size(); i++) pe_dom[i]->stop();
+        if (--systems_running == 0) sc_stop();
+    }
+
+    uint64_t total_tiles() const {
+        uint64_t t = 0;
+        for (size_t l = 0; l < cfg.layers.size(); l++) t += cfg.layers[l];
+        return t;
+    }
+
+    static double domain_energy(const std::vector<clock_domain_sc*>& d) {
+        double e = 0.0;
+        for (size_t i = 0; i < d.size(); i++) e += d[i]->energy_pj();
+        return e;
+    }
+
+    double cdc_latency_ns() const {
+        double sum = 0.0;
+        uint64_t n = 0;
+        for (size_t i = 0; i < pe_links.size(); i++) {
+            sum += pe_links[i]->avg_latency_ns() * pe_links[i]->crossings;
+            n += pe_links[i]->crossings;
+        }
+        return n ? sum / n : 0.0;
+    }
+};
+
+static chip_config scenario(const chip_config& base, const char* name, double noc_mhz, double noc_v,
+                            double pe_mhz, double pe_v, int policy) {
+    chip_config c = base;
+    c.name = name;
+    c.noc_op = { noc_mhz, noc_v };
+    c.pe_op = { pe_mhz, pe_v };
+    c.policy = policy;
+    return c;
+}
+
+int sc_main(int argc, char* argv[]) {
+    chip_config base;
+    bool verbose = false;
+    for (int i = 1; i < argc; i++) {
+        const char* eq = std::strchr(argv[i], '=');
+        if (!eq) continue;
+        std::string key(argv[i], eq - argv[i]);
+        double val = std::atof(eq + 1);
+        if (key == "x") base.cores_x = (int)val;
+        else if (key == "y") base.cores_y = (int)val;
+        else if (key == "flits") base.tile_flits = (int)val;
+        else if (key == "cycles") base.tile_cycles = (int)val;
+        else if (key == "threshold") base.idle_threshold = (int)val;
+        else if (key == "gap") base.host_gap = (int)val;
+        else if (key == "idle_mhz") base.idle_op.freq_mhz = val;
+        else if (key == "verbose") verbose = val != 0.0;
+    }
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "Multi-Clock-Domain Chip (ESL) - DVFS Study" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << base.cores_x << "x" << base.cores_y << " mesh, " << base.tile_flits
+              << " flits + " << base.tile_cycles << " PE cycles per tile, layers:";
+    for (size_t l = 0; l < base.layers.size(); l++) std::cout << " " << base.layers[l];
+    std::cout << std::endl;
+
+    // Frequency ratio sweep and idle-core power management
+    std::vector<chip_config> configs;
+    configs.push_back(scenario(base, "baseline",  1000, 0.90, 1000, 0.90, PM_NONE));
+    configs.push_back(scenario(base, "noc_half",   500, 0.75, 1000, 0.90, PM_NONE));
+    configs.push_back(scenario(base, "noc_2x",    2000, 1.05, 1000, 0.90, PM_NONE));
+    configs.push_back(scenario(base, "pe_half",   1000, 0.90,  500, 0.75, PM_NONE));
+    configs.push_back(scenario(base, "dvfs_idle", 1000, 0.90, 1000, 0.90, PM_DVFS));
+    configs.push_back(scenario(base, "gate_idle", 1000, 0.90, 1000, 0.90, PM_GATE));
+    configs.push_back(scenario(base, "noc_half+dvfs", 500, 0.75, 1000, 0.90, PM_DVFS));
+
+    std::vector<chip_esl*> chips;
+    for (size_t i = 0; i < configs.size(); i++) {
+        chips.push_back(new chip_esl(sc_gen_unique_name("chip"), configs[i]));
+    }
+
+    sc_start(1, SC_MS);
+    if (systems_running != 0) {
+        std::cout << "FAILURE: " << systems_running << " scenarios did not finish" << std::endl;
+        return 1;
+    }
+
+    // ========================================
+    // Results
+    // ========================================
+    const double base_tput = chips[0]->total_tiles() / (chips[0]->dispatcher->finish.to_seconds() * 1e6);
+    int failed = 0;
+    std::cout << std::left << std::setw(15) << "Scenario" << std::right
+              << std::setw(6) << "NoC" << std::setw(6) << "PE" << std::setw(6) << "PM"
+              << std::setw(10) << "Time(us)" << std::setw(10) << "Tiles/us"
+              << std::setw(8) << "dTput" << std::setw(10) << "NoC(nJ)"
+              << std::setw(10) << "PE(nJ)" << std::setw(10) << "nJ/tile"
+              << std::setw(10) << "CDC(ns)" << std::endl;
+    for (size_t i = 0; i < chips.size(); i++) {
+        chip_esl* c = chips[i];
+        uint64_t tiles = 0;
+        for (size_t p = 0; p < c->pes.size(); p++) tiles += c->pes[p]->tiles;
+        if (tiles != c->total_tiles()) failed++;
+
+        const double us = c->dispatcher->finish.to_seconds() * 1e6;
+        const double tput = tiles / us;
+        const double e_noc = chip_esl::domain_energy(c->noc_dom) / 1000.0;
+        const double e_pe = chip_esl::domain_energy(c->pe_dom) / 1000.0;
+        std::cout << std::left << std::setw(15) << c->cfg.name << std::right << std::fixed
+                  << std::setprecision(0)
+                  << std::setw(6) << c->cfg.noc_op.freq_mhz << std::setw(6) << c->cfg.pe_op.freq_mhz
+                  << std::setw(6) << policy_name(c->cfg.policy)
+                  << std::setprecision(2) << std::setw(10) << us << std::setw(10) << tput
+                  << std::setprecision(1) << std::setw(7) << (tput / base_tput - 1.0) * 100.0 << "%"
+                  << std::setw(10) << e_noc << std::setw(10) << e_pe
+                  << std::setprecision(2) << std::setw(10) << (e_noc + e_pe) / tiles
+                  << std::setw(10) << c->cdc_latency_ns() << std::defaultfloat << std::endl;
+    }
+
+    if (verbose) {
+        for (size_t i = 0; i < chips.size(); i++) {
+            std::cout << "\nPer-domain detail: " << chips[i]->cfg.name << std::endl;
+            for (size_t d = 0; d < chips[i]->noc_dom.size(); d++) chips[i]->noc_dom[d]->report(std::cout);
+            for (size_t d = 0; d < chips[i]->pe_dom.size(); d++) chips[i]->pe_dom[d]->report(std::cout);
+        }
+    }
+
+    std::cout << "\n========================================" << std::endl;
+    if (failed == 0) {
+        std::cout << "SUCCESS: All " << chips.size() << " scenarios completed every tile!" << std::endl;
+    } else {
+        std::cout << "FAILURE: " << failed << " scenarios lost tiles!" << std::endl;
+    }
+    std::cout << "========================================" << std::endl;
+
+    return failed ? 1 : 0;
+}